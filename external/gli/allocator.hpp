@@ -0,0 +1,149 @@
+/// @brief Include to control how texture storage memory is allocated.
+/// @file gli/allocator.hpp
+
+#pragma once
+
+#include "type.hpp"
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gli
+{
+	/// Initialization of the memory of a new texture storage
+	enum storage_init
+	{
+		STORAGE_INIT_ZERO,	///< Fill the memory with zeros
+		STORAGE_INIT_NONE	///< Leave the memory uninitialized, for textures about to be entirely overwritten
+	};
+
+	/// Order of the texels of the images in the memory of a texture storage
+	enum storage_layout
+	{
+		STORAGE_LAYOUT_LINEAR,	///< Rows of texels, then slices of rows. The layout of files and graphics APIs
+		STORAGE_LAYOUT_TILED	///< Tiles of 4x4 texels in rows of tiles, then slices, for accesses to neighbouring texels. Uncompressed formats only
+	};
+
+	/// Interface of the allocators providing the memory of texture storages.
+	/// A storage keeps its allocator alive until its memory is deallocated.
+	class allocator
+	{
+	public:
+		virtual ~allocator(){}
+
+		/// Allocate Size bytes, returns nullptr on failure.
+		virtual void* allocate(size_t Size) = 0;
+
+		/// Deallocate memory returned by allocate(Size).
+		virtual void deallocate(void* Pointer, size_t Size) = 0;
+
+		/// Whether the memory returned by allocate(Size) reads as zeros, storages then skip clearing it.
+		virtual bool zeroed(size_t /*Size*/) const{return false;}
+
+		/// Return the number of bytes of allocated memory from Pointer to Pointer + Size backed by physical memory.
+		virtual size_t resident_size(void const* /*Pointer*/, size_t Size) const{return Size;}
+
+		/// Release the physical memory of the pages from Pointer to Pointer + Size, returns false if the allocator doesn't support it.
+		virtual bool evict(void* /*Pointer*/, size_t /*Size*/){return false;}
+	};
+
+	/// Allocate on the heap, aligned to Alignment bytes. The default allocator, aligned to 16 bytes.
+	class allocator_heap : public allocator
+	{
+	public:
+		/// @param Alignment Power of two multiple of sizeof(void*)
+		explicit allocator_heap(size_t Alignment = 16);
+
+		void* allocate(size_t Size) override;
+		void deallocate(void* Pointer, size_t Size) override;
+
+	private:
+		size_t const Alignment;
+	};
+
+	/// Allocate large storages in memory backed by transparent huge pages where the platform supports it,
+	/// smaller ones or all of them elsewhere from the heap.
+	class allocator_huge_page : public allocator
+	{
+	public:
+		/// @param MinSize Size from which the allocations are backed by huge pages
+		explicit allocator_huge_page(size_t MinSize = 2 * 1024 * 1024);
+
+		void* allocate(size_t Size) override;
+		void deallocate(void* Pointer, size_t Size) override;
+		bool zeroed(size_t Size) const override;
+
+	private:
+		size_t const MinSize;
+		allocator_heap Heap;
+	};
+
+	/// Keep deallocated memory to satisfy following allocations of the same size,
+	/// for textures created and destroyed repeatedly. Thread safe.
+	class allocator_pool : public allocator
+	{
+	public:
+		/// @param Upstream Allocator of the memory when none of the right size is kept, the default allocator if null
+		/// @param Capacity Maximum number of bytes kept for reuse
+		explicit allocator_pool(std::shared_ptr<allocator> const& Upstream = nullptr, size_t Capacity = 64 * 1024 * 1024);
+		~allocator_pool();
+
+		void* allocate(size_t Size) override;
+		void deallocate(void* Pointer, size_t Size) override;
+		size_t resident_size(void const* Pointer, size_t Size) const override;
+		bool evict(void* Pointer, size_t Size) override;
+
+		/// Return the memory kept for reuse to the upstream allocator.
+		void release();
+
+		allocator_pool(allocator_pool const&) = delete;
+		allocator_pool& operator=(allocator_pool const&) = delete;
+
+	private:
+		std::shared_ptr<allocator> const Upstream;
+		size_t const Capacity;
+		size_t CachedSize;
+		std::map<size_t, std::vector<void*> > Cache;
+		std::mutex Mutex;
+	};
+
+	/// Reserve address space for each storage and let the system back it with memory when it is first written, page by page,
+	/// so that the memory used follows the texels written rather than the size of the textures. Pages never written read as zeros.
+	/// With a backing directory, each storage is mapped on a temporary file created there and evicted pages are written back to it,
+	/// otherwise evicted pages are discarded and read as zeros again. Falls back to zeroed heap memory where mapping isn't available.
+	class allocator_sparse : public allocator
+	{
+	public:
+		/// @param PageSize Granularity of the evictions, a multiple of the system page size
+		/// @param BackingDirectory Directory of the temporary backing files, none if empty
+		explicit allocator_sparse(size_t PageSize = 64 * 1024, std::string const& BackingDirectory = std::string());
+
+		void* allocate(size_t Size) override;
+		void deallocate(void* Pointer, size_t Size) override;
+		bool zeroed(size_t Size) const override;
+		size_t resident_size(void const* Pointer, size_t Size) const override;
+
+		/// Release the pages entirely within Pointer to Pointer + Size, writing them back to the backing file if any.
+		bool evict(void* Pointer, size_t Size) override;
+
+		/// Return the granularity of the evictions
+		size_t page_size() const;
+
+	private:
+		size_t const PageSize;
+		std::string const BackingDirectory;
+		allocator_heap Heap;
+	};
+
+	/// Return the allocator of the storages created without an explicit one.
+	std::shared_ptr<allocator> const& default_allocator();
+
+	/// Replace the allocator of the storages created without an explicit one, the heap allocator if null.
+	/// Not thread safe, call it before creating textures.
+	void set_default_allocator(std::shared_ptr<allocator> const& Allocator);
+}//namespace gli
+
+#include "./core/allocator.inl"
@@ -20,7 +20,8 @@ namespace gli
 	/// Compare two images. Two images are equal when the date is the same.
 	bool operator!=(image const& ImageA, image const& ImageB);
 
-	/// Compare two textures. Two textures are the same when the data, the format and the targets are the same.
+	/// Compare two textures. Two textures are the same when the data, the format, the layout and the targets are the same.
+	/// The images which hashes are cached for both textures, see gli::hash, are compared by hash first.
 	bool operator==(texture const& A, texture const& B);
 
 	/// Compare two textures. Two textures are the same when the data, the format and the targets are the same.
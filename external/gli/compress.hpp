@@ -0,0 +1,38 @@
+/// @brief Include to compress textures in BC1, BC3, BC4 and BC5 formats.
+/// @file gli/compress.hpp
+
+#pragma once
+
+#include "convert.hpp"
+#include "layout.hpp"
+
+namespace gli
+{
+	/// Trade-off between the time of compression and the quality of compressed textures
+	enum compression_quality
+	{
+		COMPRESSION_QUALITY_FAST, COMPRESSION_QUALITY_FIRST = COMPRESSION_QUALITY_FAST,
+		COMPRESSION_QUALITY_HIGH, COMPRESSION_QUALITY_LAST = COMPRESSION_QUALITY_HIGH
+	};
+
+	enum
+	{
+		COMPRESSION_QUALITY_COUNT = COMPRESSION_QUALITY_LAST - COMPRESSION_QUALITY_FIRST + 1
+	};
+
+	/// Compress a texture in a block compressed format. Blocks are compressed in parallel with the default executor.
+	/// Formats other than RGBA8 are converted to it first, in the color space of the destination format.
+	///
+	/// @param Texture Source texture, the format must be uncompressed.
+	/// @param Format Destination texture format: FORMAT_RGB_DXT1_*, FORMAT_RGBA_DXT1_*, FORMAT_RGBA_DXT5_*, FORMAT_R_ATI1N_UNORM_BLOCK8 or FORMAT_RG_ATI2N_UNORM_BLOCK16.
+	/// With FORMAT_RGBA_DXT1_*, texels with an alpha under 0.5 are encoded transparent.
+	/// @param Quality COMPRESSION_QUALITY_FAST fits the endpoints of the blocks to their bounding box,
+	/// COMPRESSION_QUALITY_HIGH also to their principal axis before refining them.
+	template <typename texture_type>
+	texture_type compress(texture_type const& Texture, format Format, compression_quality Quality = COMPRESSION_QUALITY_FAST);
+
+	/// Evaluate whether gli::compress can compress textures to a format
+	bool is_compressible(format Format);
+}//namespace gli
+
+#include "./core/compress.inl"
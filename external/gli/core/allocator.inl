@@ -0,0 +1,315 @@
+#include <glm/simd/platform.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+#	include <malloc.h>
+#elif GLM_PLATFORM & (GLM_PLATFORM_LINUX | GLM_PLATFORM_ANDROID)
+#	define GLI_USE_HUGE_PAGES
+#	include <sys/mman.h>
+#endif
+
+#if GLM_PLATFORM & (GLM_PLATFORM_LINUX | GLM_PLATFORM_ANDROID | GLM_PLATFORM_APPLE | GLM_PLATFORM_UNIX)
+#	define GLI_USE_SPARSE
+#	include <sys/mman.h>
+#	include <unistd.h>
+#	include <vector>
+#endif
+
+namespace gli{
+namespace detail
+{
+#	ifdef GLI_USE_SPARSE
+		// Platforms without MAP_NORESERVE commit the pages of anonymous mappings on first write anyway
+#		ifdef MAP_NORESERVE
+			static int const MapNoReserve = MAP_NORESERVE;
+#		else
+			static int const MapNoReserve = 0;
+#		endif
+#	endif//GLI_USE_SPARSE
+
+	inline std::shared_ptr<allocator>& default_allocator_instance()
+	{
+		static std::shared_ptr<allocator> Allocator(std::make_shared<allocator_heap>());
+		return Allocator;
+	}
+}//namespace detail
+
+	inline allocator_heap::allocator_heap(size_t Alignment)
+		: Alignment(Alignment)
+	{
+		GLI_ASSERT(Alignment >= sizeof(void*) && (Alignment & (Alignment - 1)) == 0);
+	}
+
+	inline void* allocator_heap::allocate(size_t Size)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return _aligned_malloc(Size, this->Alignment);
+#		else
+			void* Pointer = nullptr;
+			if(posix_memalign(&Pointer, this->Alignment, Size) != 0)
+				return nullptr;
+			return Pointer;
+#		endif
+	}
+
+	inline void allocator_heap::deallocate(void* Pointer, size_t)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			_aligned_free(Pointer);
+#		else
+			std::free(Pointer);
+#		endif
+	}
+
+	inline allocator_huge_page::allocator_huge_page(size_t MinSize)
+		: MinSize(MinSize)
+		, Heap(64)
+	{}
+
+	inline void* allocator_huge_page::allocate(size_t Size)
+	{
+#		ifdef GLI_USE_HUGE_PAGES
+			if(Size >= this->MinSize)
+			{
+				void* Pointer = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if(Pointer == MAP_FAILED)
+					return nullptr;
+#				ifdef MADV_HUGEPAGE
+					madvise(Pointer, Size, MADV_HUGEPAGE);
+#				endif
+				return Pointer;
+			}
+#		endif//GLI_USE_HUGE_PAGES
+
+		return this->Heap.allocate(Size);
+	}
+
+	inline void allocator_huge_page::deallocate(void* Pointer, size_t Size)
+	{
+#		ifdef GLI_USE_HUGE_PAGES
+			if(Size >= this->MinSize)
+			{
+				munmap(Pointer, Size);
+				return;
+			}
+#		endif//GLI_USE_HUGE_PAGES
+
+		this->Heap.deallocate(Pointer, Size);
+	}
+
+	inline bool allocator_huge_page::zeroed(size_t Size) const
+	{
+		// Anonymous mappings are zero filled by the system
+#		ifdef GLI_USE_HUGE_PAGES
+			return Size >= this->MinSize;
+#		else
+			static_cast<void>(Size);
+			return false;
+#		endif//GLI_USE_HUGE_PAGES
+	}
+
+	inline allocator_pool::allocator_pool(std::shared_ptr<allocator> const& Upstream, size_t Capacity)
+		: Upstream(Upstream ? Upstream : default_allocator())
+		, Capacity(Capacity)
+		, CachedSize(0)
+	{}
+
+	inline allocator_pool::~allocator_pool()
+	{
+		this->release();
+	}
+
+	inline void* allocator_pool::allocate(size_t Size)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+
+			std::map<size_t, std::vector<void*> >::iterator it = this->Cache.find(Size);
+			if(it != this->Cache.end() && !it->second.empty())
+			{
+				void* Pointer = it->second.back();
+				it->second.pop_back();
+				this->CachedSize -= Size;
+				return Pointer;
+			}
+		}
+
+		return this->Upstream->allocate(Size);
+	}
+
+	inline void allocator_pool::deallocate(void* Pointer, size_t Size)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+
+			if(this->CachedSize + Size <= this->Capacity)
+			{
+				this->Cache[Size].push_back(Pointer);
+				this->CachedSize += Size;
+				return;
+			}
+		}
+
+		this->Upstream->deallocate(Pointer, Size);
+	}
+
+	inline void allocator_pool::release()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		for(std::map<size_t, std::vector<void*> >::iterator it = this->Cache.begin(); it != this->Cache.end(); ++it)
+		for(size_t i = 0, n = it->second.size(); i < n; ++i)
+			this->Upstream->deallocate(it->second[i], it->first);
+
+		this->Cache.clear();
+		this->CachedSize = 0;
+	}
+
+	inline size_t allocator_pool::resident_size(void const* Pointer, size_t Size) const
+	{
+		return this->Upstream->resident_size(Pointer, Size);
+	}
+
+	inline bool allocator_pool::evict(void* Pointer, size_t Size)
+	{
+		return this->Upstream->evict(Pointer, Size);
+	}
+
+	inline allocator_sparse::allocator_sparse(size_t PageSize, std::string const& BackingDirectory)
+		: PageSize(PageSize)
+		, BackingDirectory(BackingDirectory)
+		, Heap(64)
+	{
+#		ifdef GLI_USE_SPARSE
+			GLI_ASSERT(PageSize > 0 && PageSize % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0);
+#		endif
+	}
+
+	inline void* allocator_sparse::allocate(size_t Size)
+	{
+#		ifdef GLI_USE_SPARSE
+			if(this->BackingDirectory.empty())
+			{
+				// Only reserve the address space, pages are committed zeroed on first write
+				void* Pointer = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | detail::MapNoReserve, -1, 0);
+				return Pointer == MAP_FAILED ? nullptr : Pointer;
+			}
+
+			// The file is unlinked right away so that it is removed when the mapping goes away, even on a crash
+			std::string const Template = this->BackingDirectory + "/gli-XXXXXX";
+			std::vector<char> Path(Template.begin(), Template.end());
+			Path.push_back('\0');
+
+			int const FileDescriptor = mkstemp(&Path[0]);
+			if(FileDescriptor == -1)
+				return nullptr;
+			unlink(&Path[0]);
+
+			void* Pointer = MAP_FAILED;
+			if(ftruncate(FileDescriptor, static_cast<off_t>(Size)) == 0)
+				Pointer = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0);
+			close(FileDescriptor);
+
+			return Pointer == MAP_FAILED ? nullptr : Pointer;
+#		else
+			void* Pointer = this->Heap.allocate(Size);
+			if(Pointer)
+				std::memset(Pointer, 0, Size);
+			return Pointer;
+#		endif//GLI_USE_SPARSE
+	}
+
+	inline void allocator_sparse::deallocate(void* Pointer, size_t Size)
+	{
+#		ifdef GLI_USE_SPARSE
+			munmap(Pointer, Size);
+#		else
+			this->Heap.deallocate(Pointer, Size);
+#		endif//GLI_USE_SPARSE
+	}
+
+	inline bool allocator_sparse::zeroed(size_t) const
+	{
+		return true;
+	}
+
+	inline size_t allocator_sparse::resident_size(void const* Pointer, size_t Size) const
+	{
+#		ifdef GLI_USE_SPARSE
+			if(Size == 0)
+				return 0;
+
+			size_t const SystemPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			size_t const Begin = reinterpret_cast<size_t>(Pointer) / SystemPageSize * SystemPageSize;
+			size_t const End = reinterpret_cast<size_t>(Pointer) + Size;
+			size_t const PageCount = (End - Begin + SystemPageSize - 1) / SystemPageSize;
+
+#			if GLM_PLATFORM & GLM_PLATFORM_APPLE
+				std::vector<char> Residency(PageCount);
+#			else
+				std::vector<unsigned char> Residency(PageCount);
+#			endif
+			if(mincore(reinterpret_cast<void*>(Begin), End - Begin, &Residency[0]) != 0)
+				return Size;
+
+			// Count the bytes of the range within each resident page
+			size_t ResidentSize = 0;
+			for(size_t PageIndex = 0; PageIndex < PageCount; ++PageIndex)
+			{
+				if(!(Residency[PageIndex] & 1))
+					continue;
+				size_t const PageBegin = std::max(Begin + PageIndex * SystemPageSize, reinterpret_cast<size_t>(Pointer));
+				size_t const PageEnd = std::min(Begin + (PageIndex + 1) * SystemPageSize, End);
+				ResidentSize += PageEnd - PageBegin;
+			}
+			return ResidentSize;
+#		else
+			return Size;
+#		endif//GLI_USE_SPARSE
+	}
+
+	inline bool allocator_sparse::evict(void* Pointer, size_t Size)
+	{
+#		ifdef GLI_USE_SPARSE
+			// Offsets within the allocation aren't known, only evict the pages aligned on the page size
+			size_t const Begin = (reinterpret_cast<size_t>(Pointer) + this->PageSize - 1) / this->PageSize * this->PageSize;
+			size_t const End = (reinterpret_cast<size_t>(Pointer) + Size) / this->PageSize * this->PageSize;
+			if(Begin >= End)
+				return true;
+
+			// Written back pages are dropped from the mapping, they may stay in the system file cache until it reclaims them
+			void* const Pages = reinterpret_cast<void*>(Begin);
+			if(!this->BackingDirectory.empty() && msync(Pages, End - Begin, MS_SYNC) != 0)
+				return false;
+			return madvise(Pages, End - Begin, MADV_DONTNEED) == 0;
+#		else
+			return false;
+#		endif//GLI_USE_SPARSE
+	}
+
+	inline size_t allocator_sparse::page_size() const
+	{
+		return this->PageSize;
+	}
+
+	inline std::shared_ptr<allocator> const& default_allocator()
+	{
+		return detail::default_allocator_instance();
+	}
+
+	inline void set_default_allocator(std::shared_ptr<allocator> const& Allocator)
+	{
+		detail::default_allocator_instance() = Allocator ? Allocator : std::make_shared<allocator_heap>();
+	}
+}//namespace gli
+
+// Platform selection private to this file
+#ifdef GLI_USE_HUGE_PAGES
+#	undef GLI_USE_HUGE_PAGES
+#endif
+#ifdef GLI_USE_SPARSE
+#	undef GLI_USE_SPARSE
+#endif
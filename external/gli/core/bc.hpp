@@ -46,6 +46,17 @@ namespace gli
 		glm::vec4 decompress_bc5snorm(const bc5_block &Block, const extent2d &BlockTexelCoord);
 		texel_block4x4 decompress_bc5unorm_block(const bc5_block &Block);
 		texel_block4x4 decompress_bc5snorm_block(const bc5_block &Block);
+
+		bc1_block compress_bc1_block(const texel_block4x4_rgba8 &Block, bool Alpha, bool HighQuality);
+		bc3_block compress_bc3_block(const texel_block4x4_rgba8 &Block, bool HighQuality);
+		bc4_block compress_bc4unorm_block(const texel_block4x4_rgba8 &Block, bool HighQuality);
+		bc5_block compress_bc5unorm_block(const texel_block4x4_rgba8 &Block, bool HighQuality);
+
+		// Decompress to 8 bits components, two's complement integers for SNORM blocks
+		texel_block4x4_rgba8 decompress_bc4unorm_block_rgba8(const bc4_block &Block);
+		texel_block4x4_rgba8 decompress_bc4snorm_block_rgba8(const bc4_block &Block);
+		texel_block4x4_rgba8 decompress_bc5unorm_block_rgba8(const bc5_block &Block);
+		texel_block4x4_rgba8 decompress_bc5snorm_block_rgba8(const bc5_block &Block);
 	}//namespace detail
 }//namespace gli
 
@@ -237,5 +237,109 @@ namespace gli
 			return TexelBlock;
 		}
 
+		inline bc1_block compress_bc1_block(const texel_block4x4_rgba8 &Block, bool Alpha, bool HighQuality)
+		{
+			return compress_dxt1_block(Block, Alpha, HighQuality);
+		}
+
+		inline bc3_block compress_bc3_block(const texel_block4x4_rgba8 &Block, bool HighQuality)
+		{
+			return compress_dxt5_block(Block, HighQuality);
+		}
+
+		inline bc4_block compress_bc4unorm_block(const texel_block4x4_rgba8 &Block, bool HighQuality)
+		{
+			bc4_block Result;
+			compress_single_channel(Block, 0, true, HighQuality, Result.Red0, Result.Red1, Result.Bitmap);
+			return Result;
+		}
+
+		inline bc5_block compress_bc5unorm_block(const texel_block4x4_rgba8 &Block, bool HighQuality)
+		{
+			bc5_block Result;
+			compress_single_channel(Block, 0, true, HighQuality, Result.Red0, Result.Red1, Result.RedBitmap);
+			compress_single_channel(Block, 1, true, HighQuality, Result.Green0, Result.Green1, Result.GreenBitmap);
+			return Result;
+		}
+
+
+		// Values of a SNORM single channel block as two's complement integers, 6 interpolated values when Channel0 > Channel1, 4 and the extremes otherwise
+		inline void compute_single_channel_palette_snorm(uint8_t Channel0, uint8_t Channel1, int *Palette)
+		{
+			int const Signed0 = glm::max(static_cast<int>(static_cast<int8_t>(Channel0)), -127);
+			int const Signed1 = glm::max(static_cast<int>(static_cast<int8_t>(Channel1)), -127);
+
+			Palette[0] = Signed0;
+			Palette[1] = Signed1;
+			if(Signed0 > Signed1)
+			{
+				for(int i = 1; i < 7; ++i)
+				{
+					int const Sum = (7 - i) * Signed0 + i * Signed1;
+					Palette[i + 1] = (Sum >= 0 ? Sum + 3 : Sum - 3) / 7;
+				}
+			}
+			else
+			{
+				for(int i = 1; i < 5; ++i)
+				{
+					int const Sum = (5 - i) * Signed0 + i * Signed1;
+					Palette[i + 1] = (Sum >= 0 ? Sum + 2 : Sum - 2) / 5;
+				}
+				Palette[6] = -127;
+				Palette[7] = 127;
+			}
+
+			for(int i = 0; i < 8; ++i)
+				Palette[i] = static_cast<uint8_t>(Palette[i]);
+		}
+
+		inline texel_block4x4_rgba8 decompress_bc4unorm_block_rgba8(const bc4_block &Block)
+		{
+			texel_block4x4_rgba8 Result;
+			std::fill(&Result.Texel[0][0], &Result.Texel[0][0] + 16, glm::u8vec4(0, 0, 0, 255));
+
+			int Palette[8];
+			compute_single_channel_palette(Block.Red0, Block.Red1, Palette);
+			expand_single_channel_indices(Block.Bitmap, Palette, 0, Result);
+			return Result;
+		}
+
+		inline texel_block4x4_rgba8 decompress_bc4snorm_block_rgba8(const bc4_block &Block)
+		{
+			texel_block4x4_rgba8 Result;
+			std::fill(&Result.Texel[0][0], &Result.Texel[0][0] + 16, glm::u8vec4(0, 0, 0, 127));
+
+			int Palette[8];
+			compute_single_channel_palette_snorm(Block.Red0, Block.Red1, Palette);
+			expand_single_channel_indices(Block.Bitmap, Palette, 0, Result);
+			return Result;
+		}
+
+		inline texel_block4x4_rgba8 decompress_bc5unorm_block_rgba8(const bc5_block &Block)
+		{
+			texel_block4x4_rgba8 Result;
+			std::fill(&Result.Texel[0][0], &Result.Texel[0][0] + 16, glm::u8vec4(0, 0, 0, 255));
+
+			int Palette[8];
+			compute_single_channel_palette(Block.Red0, Block.Red1, Palette);
+			expand_single_channel_indices(Block.RedBitmap, Palette, 0, Result);
+			compute_single_channel_palette(Block.Green0, Block.Green1, Palette);
+			expand_single_channel_indices(Block.GreenBitmap, Palette, 1, Result);
+			return Result;
+		}
+
+		inline texel_block4x4_rgba8 decompress_bc5snorm_block_rgba8(const bc5_block &Block)
+		{
+			texel_block4x4_rgba8 Result;
+			std::fill(&Result.Texel[0][0], &Result.Texel[0][0] + 16, glm::u8vec4(0, 0, 0, 127));
+
+			int Palette[8];
+			compute_single_channel_palette_snorm(Block.Red0, Block.Red1, Palette);
+			expand_single_channel_indices(Block.RedBitmap, Palette, 0, Result);
+			compute_single_channel_palette_snorm(Block.Green0, Block.Green1, Palette);
+			expand_single_channel_indices(Block.GreenBitmap, Palette, 1, Result);
+			return Result;
+		}
 	}//namespace detail
 }//namespace gli
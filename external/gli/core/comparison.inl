@@ -10,6 +10,18 @@ namespace detail
 		if(TextureA.data() == TextureB.data())
 			return true;
 
+		for(texture::size_type LayerIndex = 0, LayerCount = TextureA.layers(); LayerIndex < LayerCount; ++LayerIndex)
+		for(texture::size_type FaceIndex = 0, FaceCount = TextureA.faces(); FaceIndex < FaceCount; ++FaceIndex)
+		for(texture::size_type LevelIndex = 0, LevelCount = TextureA.levels(); LevelIndex < LevelCount; ++LevelIndex)
+		{
+			// Images which hashes are cached and different can't be equal, equal hashes still need the data to be compared
+			uint64 HashA = 0, HashB = 0;
+			if(TextureA.size(LevelIndex) != TextureB.size(LevelIndex))
+				continue;
+			if(TextureA.cached_hash(LayerIndex, FaceIndex, LevelIndex, HashA) && TextureB.cached_hash(LayerIndex, FaceIndex, LevelIndex, HashB) && HashA != HashB)
+				return false;
+		}
+
 		for(texture::size_type LayerIndex = 0, LayerCount = TextureA.layers(); LayerIndex < LayerCount; ++LayerIndex)
 		for(texture::size_type FaceIndex = 0, FaceCount = TextureA.faces(); FaceIndex < FaceCount; ++FaceIndex)
 		for(texture::size_type LevelIndex = 0, LevelCount = TextureA.levels(); LevelIndex < LevelCount; ++LevelIndex)
@@ -60,6 +72,8 @@ namespace detail
 			return false;
 		if(TextureA.format() != TextureB.format())
 			return false;
+		if(TextureA.layout() != TextureB.layout())
+			return false;
 		if(TextureA.size() != TextureB.size())
 			return false;
 
@@ -82,6 +96,8 @@ namespace detail
 			return true;
 		if(TextureA.format() != TextureB.format())
 			return true;
+		if(TextureA.layout() != TextureB.layout())
+			return true;
 		if(TextureA.size() != TextureB.size())
 			return true;
 
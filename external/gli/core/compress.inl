@@ -0,0 +1,107 @@
+#include "./bc.hpp"
+
+namespace gli{
+namespace detail
+{
+	// Gather the texels of the block at BlockCoord of a RGBA8 image, repeating the last row and column for blocks crossing the edges
+	inline void fetch_texel_block4x4(glm::u8vec4 const* Data, texture::extent_type const& Extent, texture::extent_type const& BlockCoord, texel_block4x4_rgba8& Block)
+	{
+		for(int Row = 0; Row < 4; ++Row)
+		{
+			int const y = std::min(BlockCoord.y * 4 + Row, Extent.y - 1);
+			glm::u8vec4 const* Line = Data + (static_cast<size_t>(BlockCoord.z) * Extent.y + y) * Extent.x;
+
+			for(int Col = 0; Col < 4; ++Col)
+				Block.Texel[Row][Col] = Line[std::min(BlockCoord.x * 4 + Col, Extent.x - 1)];
+		}
+	}
+
+	inline void compress_block(format Format, texel_block4x4_rgba8 const& Block, bool HighQuality, glm::byte* Dst)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			*reinterpret_cast<bc1_block*>(Dst) = compress_bc1_block(Block, false, HighQuality);
+			break;
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			*reinterpret_cast<bc1_block*>(Dst) = compress_bc1_block(Block, true, HighQuality);
+			break;
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			*reinterpret_cast<bc3_block*>(Dst) = compress_bc3_block(Block, HighQuality);
+			break;
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			*reinterpret_cast<bc4_block*>(Dst) = compress_bc4unorm_block(Block, HighQuality);
+			break;
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			*reinterpret_cast<bc5_block*>(Dst) = compress_bc5unorm_block(Block, HighQuality);
+			break;
+		default:
+			GLI_ASSERT(0);
+			break;
+		}
+	}
+}//namespace detail
+
+	inline bool is_compressible(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	template <typename texture_type>
+	inline texture_type compress(texture_type const& Texture, format Format, compression_quality Quality)
+	{
+		typedef typename texture::extent_type extent_type;
+
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(!is_compressed(Texture.format()));
+		GLI_ASSERT(is_compressible(Format));
+
+		// Blocks are compressed from 8 bits components, in the color space of the destination format
+		format const SourceFormat = is_srgb(Format) ? FORMAT_RGBA8_SRGB_PACK8 : FORMAT_RGBA8_UNORM_PACK8;
+		texture_type const Converted(Texture.format() == SourceFormat ? Texture : convert(Texture, SourceFormat));
+
+		// Texels are fetched by rows
+		texture_type const Source(Converted.layout() == STORAGE_LAYOUT_LINEAR ? Converted : convert_layout(Converted, STORAGE_LAYOUT_LINEAR));
+
+		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), default_allocator(), STORAGE_INIT_NONE, Texture.swizzles());
+
+		extent_type const BlockExtent(block_extent(Format));
+		size_t const BlockSize = block_size(Format);
+		bool const HighQuality = Quality == COMPRESSION_QUALITY_HIGH;
+
+		detail::for_each_image_band(detail::split_image_bands(Storage, 0, Storage.layers() - 1, 0, Storage.faces() - 1, 0, Storage.levels() - 1), [&](detail::image_band const& Band)
+		{
+			extent_type const Extent(Source.texture::extent(Band.Level));
+			extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+
+			glm::u8vec4 const* SrcData = static_cast<glm::u8vec4 const*>(Source.texture::data(Band.Layer, Band.Face, Band.Level));
+			glm::byte* DstData = static_cast<glm::byte*>(Storage.data(Band.Layer, Band.Face, Band.Level));
+
+			detail::texel_block4x4_rgba8 Block;
+			for(int Row = Band.Begin; Row < Band.End; ++Row)
+			for(int BlockX = 0; BlockX < BlockCount.x; ++BlockX)
+			{
+				detail::fetch_texel_block4x4(SrcData, Extent, extent_type(BlockX, Row % BlockCount.y, Row / BlockCount.y), Block);
+				detail::compress_block(Format, Block, HighQuality, DstData + (static_cast<size_t>(Row) * BlockCount.x + BlockX) * BlockSize);
+			}
+		});
+
+		return texture_type(Storage);
+	}
+}//namespace gli
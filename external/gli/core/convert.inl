@@ -1,4 +1,5 @@
 #include "../core/convert_func.hpp"
+#include "../core/convert_bulk.hpp"
 
 namespace gli
 {
@@ -15,28 +16,51 @@ namespace gli
 		GLI_ASSERT(!Texture.empty());
 		GLI_ASSERT(!is_compressed(Texture.format()) && !is_compressed(Format));
 
+		std::vector<detail::image_band> const Bands(detail::split_image_bands(Texture, 0, Texture.layers() - 1, 0, Texture.faces() - 1, 0, Texture.levels() - 1));
+
+		// Common format pairs are converted a band at a time, texels being contiguous in memory.
+		// The converted texture has the layout of the source so that texels are at the same offsets.
+		detail::convert_texels_func const Bulk = detail::find_convert_texels(Texture.format(), Format);
+		if(Bulk)
+		{
+			texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), default_allocator(), STORAGE_INIT_NONE, Texture.swizzles(), Texture.layout());
+
+			size_type const SrcBlockSize = block_size(Texture.format());
+			size_type const DstBlockSize = block_size(Format);
+
+			detail::for_each_image_band(Bands, [&](detail::image_band const& Band)
+			{
+				size_type const Width = static_cast<size_type>(Texture.texture::extent(Band.Level).x);
+				size_type const Offset = static_cast<size_type>(Band.Begin) * Width;
+
+				Bulk(
+					static_cast<glm::byte const*>(Texture.texture::data(Band.Layer, Band.Face, Band.Level)) + Offset * SrcBlockSize,
+					static_cast<glm::byte*>(Storage.data(Band.Layer, Band.Face, Band.Level)) + Offset * DstBlockSize,
+					static_cast<size_type>(Band.End - Band.Begin) * Width);
+			});
+
+			return texture_type(Storage);
+		}
+
 		fetch_type Fetch = detail::convert<texture_type, T, defaultp>::call(Texture.format()).Fetch;
 		write_type Write = detail::convert<texture_type, T, defaultp>::call(Format).Write;
 
-		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
+		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), default_allocator(), STORAGE_INIT_ZERO, Texture.swizzles(), Texture.layout());
 		texture_type Copy(Storage);
 
-		for(size_type Layer = 0; Layer < Texture.layers(); ++Layer)
-		for(size_type Face = 0; Face < Texture.faces(); ++Face)
-		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+		detail::for_each_image_band(Bands, [&](detail::image_band const& Band)
 		{
-			extent_type const& Dimensions = Texture.texture::extent(Level);
+			extent_type const& Dimensions = Texture.texture::extent(Band.Level);
 
-			for(component_type k = 0; k < Dimensions.z; ++k)
-			for(component_type j = 0; j < Dimensions.y; ++j)
+			for(component_type Row = Band.Begin; Row < Band.End; ++Row)
 			for(component_type i = 0; i < Dimensions.x; ++i)
 			{
-				typename texture_type::extent_type const Texelcoord(extent_type(i, j, k));
+				typename texture_type::extent_type const Texelcoord(extent_type(i, Row % Dimensions.y, Row / Dimensions.y));
 				Write(
-					Copy, Texelcoord, Layer, Face, Level,
-					Fetch(Texture, Texelcoord, Layer, Face, Level));
+					Copy, Texelcoord, Band.Layer, Band.Face, Band.Level,
+					Fetch(Texture, Texelcoord, Band.Layer, Band.Face, Band.Level));
 			}
-		}
+		});
 
 		return texture_type(Copy);
 	}
@@ -0,0 +1,391 @@
+/// @brief Bulk texel conversion kernels used by gli::convert for the common format pairs
+/// @file gli/core/convert_bulk.hpp
+
+#pragma once
+
+#include "../format.hpp"
+#include "../type.hpp"
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/color_space.hpp>
+#include <cstring>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	// Each codec reproduces the fetch and write of the matching convertFunc mode so that
+	// the bulk kernels produce the same bytes as the per-texel path.
+
+	template <length_t L>
+	struct codec_norm8
+	{
+		typedef vec<L, u8, defaultp> texel_type;
+
+		static vec<4, float, defaultp> fetch(texel_type const& Texel)
+		{
+			return make_vec4<float, defaultp>(compNormalize<float>(Texel));
+		}
+
+		static texel_type write(vec<4, float, defaultp> const& Texel)
+		{
+			return compScale<u8>(vec<L, float, defaultp>(Texel));
+		}
+	};
+
+	// Linear value of every 8 bits sRGB encoded component
+	inline float const* srgb8_to_linear_table()
+	{
+		struct table
+		{
+			table()
+			{
+				for(int i = 0; i < 256; ++i)
+					this->Data[i] = convertSRGBToLinear(compNormalize<float>(vec<1, u8, defaultp>(static_cast<u8>(i)))).x;
+			}
+
+			float Data[256];
+		};
+
+		static table const Table;
+		return Table.Data;
+	}
+
+	template <length_t L>
+	struct codec_srgb8
+	{
+		typedef vec<L, u8, defaultp> texel_type;
+
+		static vec<4, float, defaultp> fetch(texel_type const& Texel);
+
+		static texel_type write(vec<4, float, defaultp> const& Texel)
+		{
+			return gli::compScale<u8>(convertLinearToSRGB(vec<L, float, defaultp>(Texel)));
+		}
+	};
+
+	template <>
+	inline vec<4, float, defaultp> codec_srgb8<3>::fetch(texel_type const& Texel)
+	{
+		float const* Table = srgb8_to_linear_table();
+		return vec<4, float, defaultp>(Table[Texel.x], Table[Texel.y], Table[Texel.z], 1.0f);
+	}
+
+	// The alpha channel isn't sRGB encoded
+	template <>
+	inline vec<4, float, defaultp> codec_srgb8<4>::fetch(texel_type const& Texel)
+	{
+		float const* Table = srgb8_to_linear_table();
+		return vec<4, float, defaultp>(Table[Texel.x], Table[Texel.y], Table[Texel.z], compNormalize<float>(vec<1, u8, defaultp>(Texel.w)).x);
+	}
+
+	template <length_t L>
+	struct codec_half
+	{
+		typedef vec<L, uint16, defaultp> texel_type;
+
+		static vec<4, float, defaultp> fetch(texel_type const& Texel)
+		{
+			return make_vec4<float, defaultp>(vec<L, float, defaultp>(unpackHalf(Texel)));
+		}
+
+		static texel_type write(vec<4, float, defaultp> const& Texel)
+		{
+			return packHalf(vec<L, float, defaultp>(Texel));
+		}
+	};
+
+	template <length_t L>
+	struct codec_float
+	{
+		typedef vec<L, float, defaultp> texel_type;
+
+		static vec<4, float, defaultp> fetch(texel_type const& Texel)
+		{
+			return make_vec4<float, defaultp>(Texel);
+		}
+
+		static texel_type write(vec<4, float, defaultp> const& Texel)
+		{
+			return texel_type(Texel);
+		}
+	};
+
+	// Convert Count contiguous texels, going through the same vec4 float intermediate as gli::convert
+	template <typename srcCodec, typename dstCodec>
+	struct convert_texels
+	{
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			typename srcCodec::texel_type const* SrcTexels = static_cast<typename srcCodec::texel_type const*>(Src);
+			typename dstCodec::texel_type* DstTexels = static_cast<typename dstCodec::texel_type*>(Dst);
+
+			for(size_t TexelIndex = 0; TexelIndex < Count; ++TexelIndex)
+				DstTexels[TexelIndex] = dstCodec::write(srcCodec::fetch(SrcTexels[TexelIndex]));
+		}
+	};
+
+	inline vec<4, u8, defaultp> expand_norm8(vec<3, u8, defaultp> const& Texel)
+	{
+		return vec<4, u8, defaultp>(Texel, static_cast<u8>(255));
+	}
+
+	inline vec<4, u8, defaultp> expand_norm8(vec<4, u8, defaultp> const& Texel)
+	{
+		return Texel;
+	}
+
+	// Normalizing and scaling back an 8 bits component is exact, so UNORM to UNORM conversions only move bytes.
+	// Component order is preserved, as with the per-texel path: BGRA8 to RGBA8 is a copy.
+	template <length_t SrcL, length_t DstL>
+	struct convert_texels<codec_norm8<SrcL>, codec_norm8<DstL> >
+	{
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			vec<SrcL, u8, defaultp> const* SrcTexels = static_cast<vec<SrcL, u8, defaultp> const*>(Src);
+			vec<DstL, u8, defaultp>* DstTexels = static_cast<vec<DstL, u8, defaultp>*>(Dst);
+
+			for(size_t TexelIndex = 0; TexelIndex < Count; ++TexelIndex)
+				DstTexels[TexelIndex] = vec<DstL, u8, defaultp>(expand_norm8(SrcTexels[TexelIndex]));
+		}
+	};
+
+	template <length_t L>
+	struct convert_texels<codec_norm8<L>, codec_norm8<L> >
+	{
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			std::memcpy(Dst, Src, Count * sizeof(vec<L, u8, defaultp>));
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template <>
+	struct convert_texels<codec_norm8<4>, codec_float<4> >
+	{
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			u8 const* SrcData = static_cast<u8 const*>(Src);
+			float* DstData = static_cast<float*>(Dst);
+
+			__m128i const Zero = _mm_setzero_si128();
+			__m128 const Max = _mm_set1_ps(255.0f);
+
+			size_t TexelIndex = 0;
+			for(; TexelIndex + 4 <= Count; TexelIndex += 4)
+			{
+				__m128i const Texels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(SrcData + TexelIndex * 4));
+				__m128i const Lo = _mm_unpacklo_epi8(Texels, Zero);
+				__m128i const Hi = _mm_unpackhi_epi8(Texels, Zero);
+
+				float* Out = DstData + TexelIndex * 4;
+				_mm_storeu_ps(Out + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Lo, Zero)), Max));
+				_mm_storeu_ps(Out + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Lo, Zero)), Max));
+				_mm_storeu_ps(Out + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Hi, Zero)), Max));
+				_mm_storeu_ps(Out + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Hi, Zero)), Max));
+			}
+
+			for(; TexelIndex < Count; ++TexelIndex)
+			{
+				vec<4, float, defaultp> const Texel = codec_norm8<4>::fetch(reinterpret_cast<vec<4, u8, defaultp> const*>(SrcData)[TexelIndex]);
+				std::memcpy(DstData + TexelIndex * 4, &Texel, sizeof(Texel));
+			}
+		}
+	};
+
+	// Components are expected in the [0, 1] range, out of range values saturate
+	template <>
+	struct convert_texels<codec_float<4>, codec_norm8<4> >
+	{
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			float const* SrcData = static_cast<float const*>(Src);
+			u8* DstData = static_cast<u8*>(Dst);
+
+			__m128 const Max = _mm_set1_ps(255.0f);
+
+			size_t TexelIndex = 0;
+			for(; TexelIndex + 4 <= Count; TexelIndex += 4)
+			{
+				float const* In = SrcData + TexelIndex * 4;
+				__m128i const A = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(In + 0), Max));
+				__m128i const B = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(In + 4), Max));
+				__m128i const C = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(In + 8), Max));
+				__m128i const D = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(In + 12), Max));
+
+				__m128i const Texels = _mm_packus_epi16(_mm_packs_epi32(A, B), _mm_packs_epi32(C, D));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(DstData + TexelIndex * 4), Texels);
+			}
+
+			for(; TexelIndex < Count; ++TexelIndex)
+			{
+				vec<4, float, defaultp> Texel;
+				std::memcpy(&Texel, SrcData + TexelIndex * 4, sizeof(Texel));
+
+				// Saturate as the packing above does, NaN included as max returns its first argument when unordered
+				Texel = min(max(vec<4, float, defaultp>(0.0f), Texel), vec<4, float, defaultp>(1.0f));
+				reinterpret_cast<vec<4, u8, defaultp>*>(DstData)[TexelIndex] = codec_norm8<4>::write(Texel);
+			}
+		}
+	};
+
+	// Exact half to float conversion including denormals, infinities and NaN payloads
+	template <>
+	struct convert_texels<codec_half<4>, codec_float<4> >
+	{
+		static __m128 half_to_float(__m128i Halves)
+		{
+			__m128i const MaskNoSign = _mm_set1_epi32(0x7fff);
+			__m128 const Magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+			__m128i const WasInfNan = _mm_set1_epi32(0x7bff);
+			__m128i const ExpInfNan = _mm_set1_epi32(255 << 23);
+
+			__m128i const ExpMant = _mm_and_si128(MaskNoSign, Halves);
+			__m128i const Sign = _mm_slli_epi32(_mm_xor_si128(Halves, ExpMant), 16);
+			__m128 const Scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(ExpMant, 13)), Magic);
+			__m128i const InfNan = _mm_and_si128(_mm_cmpgt_epi32(ExpMant, WasInfNan), ExpInfNan);
+
+			return _mm_or_ps(Scaled, _mm_castsi128_ps(_mm_or_si128(Sign, InfNan)));
+		}
+
+		static void call(void const* Src, void* Dst, size_t Count)
+		{
+			uint16 const* SrcData = static_cast<uint16 const*>(Src);
+			float* DstData = static_cast<float*>(Dst);
+
+			__m128i const Zero = _mm_setzero_si128();
+
+			size_t TexelIndex = 0;
+			for(; TexelIndex + 2 <= Count; TexelIndex += 2)
+			{
+				__m128i const Texels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(SrcData + TexelIndex * 4));
+
+				float* Out = DstData + TexelIndex * 4;
+				_mm_storeu_ps(Out + 0, half_to_float(_mm_unpacklo_epi16(Texels, Zero)));
+				_mm_storeu_ps(Out + 4, half_to_float(_mm_unpackhi_epi16(Texels, Zero)));
+			}
+
+			for(; TexelIndex < Count; ++TexelIndex)
+			{
+				vec<4, float, defaultp> const Texel = codec_half<4>::fetch(reinterpret_cast<vec<4, uint16, defaultp> const*>(SrcData)[TexelIndex]);
+				std::memcpy(DstData + TexelIndex * 4, &Texel, sizeof(Texel));
+			}
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	typedef void (*convert_texels_func)(void const* Src, void* Dst, size_t Count);
+
+	enum bulk_codec
+	{
+		BULK_CODEC_NONE,
+		BULK_CODEC_NORM8_3,
+		BULK_CODEC_NORM8_4,
+		BULK_CODEC_SRGB8_3,
+		BULK_CODEC_SRGB8_4,
+		BULK_CODEC_HALF_4,
+		BULK_CODEC_FLOAT_4,
+		BULK_CODEC_COUNT
+	};
+
+	inline bulk_codec find_bulk_codec(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB8_UNORM_PACK8:
+		case FORMAT_BGR8_UNORM_PACK8:
+			return BULK_CODEC_NORM8_3;
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_BGRA8_UNORM_PACK8:
+			return BULK_CODEC_NORM8_4;
+		case FORMAT_RGB8_SRGB_PACK8:
+		case FORMAT_BGR8_SRGB_PACK8:
+			return BULK_CODEC_SRGB8_3;
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_BGRA8_SRGB_PACK8:
+			return BULK_CODEC_SRGB8_4;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			return BULK_CODEC_HALF_4;
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			return BULK_CODEC_FLOAT_4;
+		default:
+			return BULK_CODEC_NONE;
+		}
+	}
+
+	/// Bulk kernel converting contiguous texels from the SrcFormat to the DstFormat.
+	/// Returns a null pointer if the pair of formats has no bulk kernel.
+	inline convert_texels_func find_convert_texels(format SrcFormat, format DstFormat)
+	{
+		static convert_texels_func const Table[BULK_CODEC_COUNT][BULK_CODEC_COUNT] =
+		{
+			// BULK_CODEC_NONE
+			{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
+			// BULK_CODEC_NORM8_3
+			{
+				nullptr,
+				convert_texels<codec_norm8<3>, codec_norm8<3> >::call,
+				convert_texels<codec_norm8<3>, codec_norm8<4> >::call,
+				nullptr,
+				nullptr,
+				nullptr,
+				convert_texels<codec_norm8<3>, codec_float<4> >::call
+			},
+			// BULK_CODEC_NORM8_4
+			{
+				nullptr,
+				convert_texels<codec_norm8<4>, codec_norm8<3> >::call,
+				convert_texels<codec_norm8<4>, codec_norm8<4> >::call,
+				nullptr,
+				nullptr,
+				nullptr,
+				convert_texels<codec_norm8<4>, codec_float<4> >::call
+			},
+			// BULK_CODEC_SRGB8_3
+			{
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				convert_texels<codec_srgb8<3>, codec_float<4> >::call
+			},
+			// BULK_CODEC_SRGB8_4
+			{
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				convert_texels<codec_srgb8<4>, codec_float<4> >::call
+			},
+			// BULK_CODEC_HALF_4
+			{
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				nullptr,
+				convert_texels<codec_half<4>, codec_float<4> >::call
+			},
+			// BULK_CODEC_FLOAT_4
+			{
+				nullptr,
+				convert_texels<codec_float<4>, codec_norm8<3> >::call,
+				convert_texels<codec_float<4>, codec_norm8<4> >::call,
+				convert_texels<codec_float<4>, codec_srgb8<3> >::call,
+				convert_texels<codec_float<4>, codec_srgb8<4> >::call,
+				convert_texels<codec_float<4>, codec_half<4> >::call,
+				convert_texels<codec_float<4>, codec_float<4> >::call
+			}
+		};
+
+		return Table[find_bulk_codec(SrcFormat)][find_bulk_codec(DstFormat)];
+	}
+}//namespace detail
+}//namespace gli
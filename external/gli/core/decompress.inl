@@ -0,0 +1,156 @@
+#include "./bc.hpp"
+#include "./convert_bulk.hpp"
+#include <cstring>
+
+namespace gli{
+namespace detail
+{
+	// Decompress a block to 8 bits components, two's complement integers for SNORM formats
+	inline texel_block4x4_rgba8 decompress_block_rgba8(format Format, glm::byte const* Data)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			return decompress_dxt1_block_rgba8(*reinterpret_cast<dxt1_block const*>(Data), false);
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			return decompress_dxt1_block_rgba8(*reinterpret_cast<dxt1_block const*>(Data), true);
+		case FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+			return decompress_dxt3_block_rgba8(*reinterpret_cast<dxt3_block const*>(Data));
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			return decompress_dxt5_block_rgba8(*reinterpret_cast<dxt5_block const*>(Data));
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			return decompress_bc4unorm_block_rgba8(*reinterpret_cast<bc4_block const*>(Data));
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+			return decompress_bc4snorm_block_rgba8(*reinterpret_cast<bc4_block const*>(Data));
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return decompress_bc5unorm_block_rgba8(*reinterpret_cast<bc5_block const*>(Data));
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			return decompress_bc5snorm_block_rgba8(*reinterpret_cast<bc5_block const*>(Data));
+		default:
+			GLI_ASSERT(0);
+			return texel_block4x4_rgba8();
+		}
+	}
+
+	// Components of the destination format for each value of the 8 bits components of decompressed blocks,
+	// for the color components and for the alpha component
+	struct decompress_tables
+	{
+		decompress_tables(format SrcFormat, format DstFormat)
+			: Identity(true)
+		{
+			float const* SRGBTable = srgb8_to_linear_table();
+
+			for(int Alpha = 0; Alpha < 2; ++Alpha)
+			for(int Value = 0; Value < 256; ++Value)
+			{
+				float Linear = Value / 255.0f;
+				if(is_snorm(SrcFormat))
+					Linear = glm::max(static_cast<int8_t>(Value) / 127.0f, -1.0f);
+				else if(is_srgb(SrcFormat) && !Alpha)
+					Linear = SRGBTable[Value];
+
+				vec<4, float, defaultp> const Texel(glm::clamp(Linear, 0.0f, 1.0f));
+				this->Float[Alpha][Value] = Linear;
+				this->Norm[Alpha][Value] = is_srgb(DstFormat) && !Alpha ? codec_srgb8<1>::write(Texel).x : codec_norm8<1>::write(Texel).x;
+				this->Identity = this->Identity && this->Norm[Alpha][Value] == Value;
+			}
+		}
+
+		float Float[2][256];
+		glm::u8 Norm[2][256];
+		bool Identity;
+	};
+}//namespace detail
+
+	inline bool is_decompressible(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	template <typename texture_type>
+	inline texture_type decompress(texture_type const& Texture, format Format)
+	{
+		typedef typename texture::extent_type extent_type;
+
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(is_decompressible(Texture.format()));
+		GLI_ASSERT(Format == FORMAT_RGBA8_UNORM_PACK8 || Format == FORMAT_RGBA8_SRGB_PACK8 || Format == FORMAT_RGBA32_SFLOAT_PACK32);
+
+		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), default_allocator(), STORAGE_INIT_NONE, Texture.swizzles());
+
+		detail::decompress_tables const Tables(Texture.format(), Format);
+		bool const Float = Format == FORMAT_RGBA32_SFLOAT_PACK32;
+		extent_type const BlockExtent(block_extent(Texture.format()));
+		size_t const SrcBlockSize = block_size(Texture.format());
+		size_t const DstBlockSize = block_size(Format);
+
+		detail::for_each_image_band(detail::split_image_bands(Texture, 0, Texture.layers() - 1, 0, Texture.faces() - 1, 0, Texture.levels() - 1), [&](detail::image_band const& Band)
+		{
+			extent_type const Extent(Texture.texture::extent(Band.Level));
+			extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+
+			glm::byte const* SrcData = static_cast<glm::byte const*>(Texture.texture::data(Band.Layer, Band.Face, Band.Level));
+			glm::byte* DstData = static_cast<glm::byte*>(Storage.data(Band.Layer, Band.Face, Band.Level));
+
+			for(int Row = Band.Begin; Row < Band.End; ++Row)
+			{
+				int const BlockY = Row % BlockCount.y;
+				int const Slice = Row / BlockCount.y;
+				int const Height = glm::min(4, Extent.y - BlockY * 4);
+
+				for(int BlockX = 0; BlockX < BlockCount.x; ++BlockX)
+				{
+					detail::texel_block4x4_rgba8 const Block = detail::decompress_block_rgba8(Texture.format(), SrcData + (static_cast<size_t>(Row) * BlockCount.x + BlockX) * SrcBlockSize);
+					int const Width = glm::min(4, Extent.x - BlockX * 4);
+
+					for(int y = 0; y < Height; ++y)
+					{
+						size_t const Texel = (static_cast<size_t>(Slice) * Extent.y + BlockY * 4 + y) * Extent.x + BlockX * 4;
+						glm::u8 const* Components = &Block.Texel[y][0][0];
+
+						if(Float)
+						{
+							float* Dst = reinterpret_cast<float*>(DstData + Texel * DstBlockSize);
+							for(int Component = 0; Component < Width * 4; ++Component)
+								Dst[Component] = Tables.Float[Component % 4 == 3][Components[Component]];
+						}
+						else if(Tables.Identity)
+						{
+							memcpy(DstData + Texel * DstBlockSize, Components, Width * DstBlockSize);
+						}
+						else
+						{
+							glm::u8* Dst = DstData + Texel * DstBlockSize;
+							for(int Component = 0; Component < Width * 4; ++Component)
+								Dst[Component] = Tables.Norm[Component % 4 == 3][Components[Component]];
+						}
+					}
+				}
+			}
+		});
+
+		return texture_type(Storage);
+	}
+}//namespace gli
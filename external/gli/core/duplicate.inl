@@ -20,17 +20,32 @@ namespace detail
 			LevelsSize += Dst.size(LevelIndex);
 		}
 
-		for(texture::size_type LayerIndex = 0, LayerCount = MaxLayer - BaseLayer + 1; LayerIndex < LayerCount; ++LayerIndex)
-		for(texture::size_type FaceIndex = 0, FaceCount = MaxFace - BaseFace + 1; FaceIndex < FaceCount; ++FaceIndex)
+		// Copies are split in chunks to be spread over the default executor
+		texture::size_type const ChunkSize = 1 << 20;
+		texture::size_type const ChunkCount = (LevelsSize + ChunkSize - 1) / ChunkSize;
+		texture::size_type const FaceCount = MaxFace - BaseFace + 1;
+		texture::size_type const LayerCount = MaxLayer - BaseLayer + 1;
+
+		default_executor()->parallel_for(LayerCount * FaceCount * ChunkCount, 1, [&](size_t Begin, size_t End)
 		{
-			memcpy(Dst.data(LayerIndex, FaceIndex, BaseLevel), Src.data(BaseLayer + LayerIndex, BaseFace + FaceIndex, BaseLevel), LevelsSize);
-		}
+			for(size_t Index = Begin; Index < End; ++Index)
+			{
+				texture::size_type const LayerIndex = Index / (FaceCount * ChunkCount);
+				texture::size_type const FaceIndex = Index / ChunkCount % FaceCount;
+				texture::size_type const Offset = Index % ChunkCount * ChunkSize;
+
+				memcpy(
+					static_cast<glm::byte*>(Dst.data(LayerIndex, FaceIndex, BaseLevel)) + Offset,
+					static_cast<glm::byte const*>(Src.data(BaseLayer + LayerIndex, BaseFace + FaceIndex, BaseLevel)) + Offset,
+					std::min(ChunkSize, LevelsSize - Offset));
+			}
+		});
 	}
 }//namespace detail
 
 	inline image duplicate(image const & Image)
 	{
-		image Result(Image.format(), Image.extent());
+		image Result(Image.format(), Image.extent(), Image.layout());
 
 		memcpy(Result.data(), Image.data(), Image.size());
 		
@@ -40,13 +55,14 @@ namespace detail
 	template <>
 	inline texture duplicate(texture const & Texture)
 	{
-		texture Duplicate(
+		texture Duplicate(detail::make_texture(
 			Texture.target(),
 			Texture.format(),
 			Texture.extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			Texture.layout()));
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -60,13 +76,14 @@ namespace detail
 	template <typename texType>
 	inline texture duplicate(texType const & Texture)
 	{
-		texture Duplicate(
+		texture Duplicate(detail::make_texture(
 			Texture.target(),
 			Texture.format(),
 			Texture.texture::extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			Texture.layout()));
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -77,18 +94,28 @@ namespace detail
 		return Duplicate;
 	}
 
+	template <typename texType>
+	inline texture duplicate_on_write(texType const& Texture)
+	{
+		if(Texture.empty())
+			return texture();
+
+		return texture(Texture, texture::COPY_ON_WRITE);
+	}
+
 	template <typename texType>
 	inline texture duplicate(texType const & Texture, typename texType::format_type Format)
 	{
 		GLI_ASSERT(block_size(Texture.format()) == block_size(Format));
 
-		texture Duplicate(
+		texture Duplicate(detail::make_texture(
 			Texture.target(),
 			Format,
-			Texture.extent(),
+			Texture.texture::extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			Texture.layout()));
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -109,10 +136,12 @@ namespace detail
 		GLI_ASSERT(BaseLevel < Texture.levels());
 		GLI_ASSERT(MaxLevel < Texture.levels());
 	
-		texture1d Duplicate(
+		texture1d Duplicate(detail::make_texture(
+			TARGET_1D,
 			Texture.format(),
-			Texture.extent(BaseLevel),
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture.extent(BaseLevel).x, 1, 1),
+			1, 1, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		memcpy(Duplicate.data(), Texture.data(0, 0, BaseLevel), Duplicate.size());
 
@@ -133,11 +162,12 @@ namespace detail
 		GLI_ASSERT(BaseLayer < Texture.layers());
 		GLI_ASSERT(MaxMayer < Texture.layers());
 
-		texture1d_array Duplicate(
+		texture1d_array Duplicate(detail::make_texture(
+			TARGET_1D_ARRAY,
 			Texture.format(),
-			Texture[BaseLayer].extent(BaseLevel),
-			MaxMayer - BaseLayer + 1,
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture[BaseLayer].extent(BaseLevel).x, 1, 1),
+			MaxMayer - BaseLayer + 1, 1, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		for(texture1d_array::size_type Layer = 0; Layer < Duplicate.layers(); ++Layer)
 			memcpy(Duplicate.data(Layer, 0, 0), Texture.data(Layer + BaseLayer, 0, BaseLevel), Duplicate[Layer].size());
@@ -155,10 +185,12 @@ namespace detail
 		GLI_ASSERT(BaseLevel < Texture.levels());
 		GLI_ASSERT(MaxLevel < Texture.levels());
 	
-		texture2d Duplicate(
+		texture2d Duplicate(detail::make_texture(
+			TARGET_2D,
 			Texture.format(),
-			Texture.extent(BaseLevel),
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture.extent(BaseLevel), 1),
+			1, 1, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		memcpy(Duplicate.data(), Texture.data(0, 0, BaseLevel), Duplicate.size());
 
@@ -179,11 +211,12 @@ namespace detail
 		GLI_ASSERT(BaseLayer < Texture.layers());
 		GLI_ASSERT(MaxMayer < Texture.layers());
 
-		texture2d_array Duplicate(
+		texture2d_array Duplicate(detail::make_texture(
+			TARGET_2D_ARRAY,
 			Texture.format(),
-			Texture.extent(BaseLevel),
-			MaxMayer - BaseLayer + 1,
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture.extent(BaseLevel), 1),
+			MaxMayer - BaseLayer + 1, 1, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		for(texture2d_array::size_type Layer = 0; Layer < Duplicate.layers(); ++Layer)
 			memcpy(Duplicate.data(Layer, 0, 0), Texture.data(Layer + BaseLayer, 0, BaseLevel), Duplicate[Layer].size());
@@ -201,10 +234,12 @@ namespace detail
 		GLI_ASSERT(BaseLevel < Texture.levels());
 		GLI_ASSERT(MaxLevel < Texture.levels());
 
-		texture3d Duplicate(
+		texture3d Duplicate(detail::make_texture(
+			TARGET_3D,
 			Texture.format(),
 			Texture.extent(BaseLevel),
-			MaxLevel - BaseLevel + 1);
+			1, 1, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		memcpy(Duplicate.data(), Texture.data(0, 0, BaseLevel), Duplicate.size());
 
@@ -223,13 +258,15 @@ namespace detail
 		GLI_ASSERT(BaseFace < Texture.faces());
 		GLI_ASSERT(MaxFace < Texture.faces());
 
-		texture_cube Duplicate(
+		texture_cube Duplicate(detail::make_texture(
+			TARGET_CUBE,
 			Texture.format(),
-			Texture[BaseFace].extent(BaseLevel),
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture[BaseFace].extent(BaseLevel), 1),
+			1, 6, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		for(texture_cube::size_type Face = 0; Face < Duplicate.faces(); ++Face)
-			memcpy(Duplicate[Face].data(), Texture[Face + BaseFace][BaseLevel].data(), Duplicate[Face].size());
+			memcpy(Duplicate.data(0, Face, 0), Texture.data(0, Face + BaseFace, BaseLevel), Duplicate[Face].size());
 
 		return Duplicate;
 	}
@@ -252,15 +289,16 @@ namespace detail
 		GLI_ASSERT(BaseLayer < Texture.layers());
 		GLI_ASSERT(MaxLayer < Texture.layers());
 
-		texture_cube_array Duplicate(
+		texture_cube_array Duplicate(detail::make_texture(
+			TARGET_CUBE_ARRAY,
 			Texture.format(),
-			Texture[BaseLayer][BaseFace].extent(BaseLevel),
-			MaxLayer - BaseLayer + 1,
-			MaxLevel - BaseLevel + 1);
+			texture::extent_type(Texture[BaseLayer][BaseFace].extent(BaseLevel), 1),
+			MaxLayer - BaseLayer + 1, 6, MaxLevel - BaseLevel + 1,
+			Texture.layout()));
 
 		for(texture_cube_array::size_type Layer = 0; Layer < Duplicate.layers(); ++Layer)
 		for(texture_cube_array::size_type Face = 0; Face < Duplicate[Layer].faces(); ++Face)
-			memcpy(Duplicate[Layer][Face].data(), Texture[Layer + BaseLayer][Face + BaseFace][BaseLevel].data(), Duplicate[Layer][Face].size());
+			memcpy(Duplicate.data(Layer, Face, 0), Texture.data(Layer + BaseLayer, Face + BaseFace, BaseLevel), Duplicate[Layer][Face].size());
 
 		return Duplicate;
 	}
@@ -2,7 +2,7 @@
 
 namespace gli
 {
-	inline dx::dx()
+	inline dx::format const* dx::get_translation()
 	{
 		static format const Table[] =
 		{
@@ -249,9 +249,39 @@ namespace gli
 		};
 		static_assert(sizeof(Table) / sizeof(Table[0]) == FORMAT_COUNT, "GLI error: format descriptor list doesn't match number of supported formats");
 
-		std::copy(&Table[0], &Table[0] + FORMAT_COUNT, this->Translation.begin());
+		return Table;
+	}
+
+	inline dx::format_map::format_map()
+	{
+		format const* Translation = get_translation();
+
+		// The first format of the table is found for Direct3D formats shared by several formats
+		for(int FormatIndex = FORMAT_FIRST; FormatIndex <= FORMAT_LAST; ++FormatIndex)
+		{
+			gli::format const Format = static_cast<gli::format>(FormatIndex);
+			dx::format const& DXFormat = Translation[FormatIndex - FORMAT_FIRST];
+
+			this->D3DFormat.insert(std::make_pair(static_cast<std::uint32_t>(DXFormat.D3DFormat), Format));
+
+			if(detail::get_format_info(Format).Flags & detail::CAP_DDS_GLI_EXT_BIT)
+				this->GLI.insert(std::make_pair(static_cast<std::uint32_t>(DXFormat.DXGIFormat.GLI), Format));
+			else
+				this->DDS.insert(std::make_pair(static_cast<std::uint32_t>(DXFormat.DXGIFormat.DDS), Format));
+		}
 	}
 
+	inline dx::format_map const& dx::get_format_map()
+	{
+		static format_map const Map;
+		return Map;
+	}
+
+	inline dx::dx()
+		: Translation(get_translation())
+		, Map(&get_format_map())
+	{}
+
 	inline dx::format const& dx::translate(gli::format Format) const
 	{
 		GLI_ASSERT(Format >= FORMAT_FIRST && Format <= FORMAT_LAST);
@@ -260,43 +290,21 @@ namespace gli
 
 	inline gli::format dx::find(dx::d3dfmt FourCC) const
 	{
-		gli::format FormatResult = static_cast<gli::format>(FORMAT_INVALID);
-		for(int FormatIndex = FORMAT_FIRST; FormatIndex <= FORMAT_LAST; ++FormatIndex)
-		{
-			if(this->Translation[FormatIndex - FORMAT_FIRST].D3DFormat != FourCC)
-				continue;
-
-			FormatResult = static_cast<gli::format>(FormatIndex);
-			break;
-		}
-		return FormatResult;
+		std::unordered_map<std::uint32_t, gli::format>::const_iterator const it = this->Map->D3DFormat.find(static_cast<std::uint32_t>(FourCC));
+		if(it == this->Map->D3DFormat.end())
+			return static_cast<gli::format>(FORMAT_INVALID);
+		return it->second;
 	}
 
 	inline gli::format dx::find(dx::d3dfmt FourCC, dx::dxgiFormat Format) const
 	{
 		GLI_ASSERT(FourCC == D3DFMT_DX10 || FourCC == D3DFMT_GLI1);
-		
-		gli::format FormatResult = static_cast<gli::format>(FORMAT_INVALID);
-		for(int FormatIndex = FORMAT_FIRST; FormatIndex <= FORMAT_LAST; ++FormatIndex)
-		{
-			gli::format CurrentFormat = static_cast<gli::format>(FormatIndex);
-			detail::formatInfo const & FormatInfo = detail::get_format_info(CurrentFormat);
-			
-			dx::format const & DXFormat = this->Translation[FormatIndex - FORMAT_FIRST];
-
-			if(FourCC == D3DFMT_GLI1 && (FormatInfo.Flags & detail::CAP_DDS_GLI_EXT_BIT) && DXFormat.DXGIFormat.GLI == Format.GLI)
-			{
-				FormatResult = static_cast<gli::format>(FormatIndex);
-				break;
-			}
-			
-			if(FourCC == D3DFMT_DX10 && !(FormatInfo.Flags & detail::CAP_DDS_GLI_EXT_BIT) && DXFormat.DXGIFormat.DDS == Format.DDS)
-			{
-				FormatResult = static_cast<gli::format>(FormatIndex);
-				break;
-			}
-		}
-		return FormatResult;
+
+		std::unordered_map<std::uint32_t, gli::format> const& Formats = FourCC == D3DFMT_GLI1 ? this->Map->GLI : this->Map->DDS;
+		std::unordered_map<std::uint32_t, gli::format>::const_iterator const it = Formats.find(FourCC == D3DFMT_GLI1 ? static_cast<std::uint32_t>(Format.GLI) : static_cast<std::uint32_t>(Format.DDS));
+		if(it == Formats.end())
+			return static_cast<gli::format>(FORMAT_INVALID);
+		return it->second;
 	}
 
 	inline bool is_dds_ext(target Target, format Format)
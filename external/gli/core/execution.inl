@@ -0,0 +1,222 @@
+#include <algorithm>
+
+namespace gli{
+namespace detail
+{
+	inline std::shared_ptr<executor>& default_executor_instance()
+	{
+		static std::shared_ptr<executor> Executor(std::make_shared<executor_sequential>());
+		return Executor;
+	}
+
+	// Whether the calling thread is running a task of an executor
+	inline bool& in_executor_task()
+	{
+		static thread_local bool InTask = false;
+		return InTask;
+	}
+
+	inline void run_sequential(size_t Count, size_t Grain, executor::task_type const& Task)
+	{
+		for(size_t Begin = 0; Begin < Count; Begin += Grain)
+			Task(Begin, std::min(Begin + Grain, Count));
+	}
+
+	// Rows of blocks [Begin, End) of an image, the rows of the successive slices of a 3D image following each other.
+	// Rows of blocks are rows of texels for uncompressed formats.
+	struct image_band
+	{
+		size_t Layer;
+		size_t Face;
+		size_t Level;
+		int Begin;
+		int End;
+	};
+
+	// Split the images in bands of about BandBlocks blocks.
+	// The split only depends on the texture so that the order of the operations doesn't depend on the executor.
+	inline std::vector<image_band> split_image_bands(
+		texture const& Texture,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
+	{
+		size_t const BandBlocks = 1 << 14;
+		texture::extent_type const BlockExtent(block_extent(Texture.format()));
+
+		std::vector<image_band> Bands;
+		for(size_t Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
+		for(size_t Face = BaseFace; Face <= MaxFace; ++Face)
+		for(size_t Level = BaseLevel; Level <= MaxLevel; ++Level)
+		{
+			texture::extent_type const BlockCount(glm::ceilMultiple(Texture.extent(Level), BlockExtent) / BlockExtent);
+			int const Rows = BlockCount.y * BlockCount.z;
+			int const BandRows = std::max(static_cast<int>(BandBlocks / static_cast<size_t>(BlockCount.x)), 1);
+
+			for(int Begin = 0; Begin < Rows; Begin += BandRows)
+			{
+				image_band const Band = {Layer, Face, Level, Begin, std::min(Begin + BandRows, Rows)};
+				Bands.push_back(Band);
+			}
+		}
+
+		return Bands;
+	}
+
+	// Call Func on each band with the default executor
+	template <typename func_type>
+	inline void for_each_image_band(std::vector<image_band> const& Bands, func_type const& Func)
+	{
+		default_executor()->parallel_for(Bands.size(), 1, [&](size_t Begin, size_t End)
+		{
+			for(size_t BandIndex = Begin; BandIndex < End; ++BandIndex)
+				Func(Bands[BandIndex]);
+		});
+	}
+}//namespace detail
+
+	inline void executor_sequential::parallel_for(size_t Count, size_t Grain, task_type const& Task)
+	{
+		detail::run_sequential(Count, std::max<size_t>(Grain, 1), Task);
+	}
+
+	inline executor_thread_pool::executor_thread_pool(size_t ThreadCount)
+		: Task(nullptr)
+		, Count(0)
+		, Grain(1)
+		, Next(0)
+		, Done(0)
+		, MemoryTag(0)
+		, Busy(false)
+		, Stop(false)
+	{
+		if(ThreadCount == 0)
+			ThreadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		for(size_t ThreadIndex = 1; ThreadIndex < ThreadCount; ++ThreadIndex)
+			this->Threads.push_back(std::thread(&executor_thread_pool::run_worker, this));
+	}
+
+	inline executor_thread_pool::~executor_thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Stop = true;
+		}
+		this->WorkCondition.notify_all();
+
+		for(size_t ThreadIndex = 0; ThreadIndex < this->Threads.size(); ++ThreadIndex)
+			this->Threads[ThreadIndex].join();
+	}
+
+	inline size_t executor_thread_pool::thread_count() const
+	{
+		return this->Threads.size() + 1;
+	}
+
+	inline void executor_thread_pool::parallel_for(size_t Count, size_t Grain, task_type const& Task)
+	{
+		Grain = std::max<size_t>(Grain, 1);
+
+		if(this->Threads.empty() || Count <= Grain || detail::in_executor_task())
+		{
+			detail::run_sequential(Count, Grain, Task);
+			return;
+		}
+
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->DoneCondition.wait(Lock, [this]{return !this->Busy;});
+
+		this->Busy = true;
+		this->Task = &Task;
+		this->Count = Count;
+		this->Grain = Grain;
+		this->Next = 0;
+		this->Done = 0;
+		this->MemoryTag = detail::current_memory_tag();
+		this->WorkCondition.notify_all();
+
+		this->run_ranges(Lock);
+		this->DoneCondition.wait(Lock, [this]{return this->Done == this->Count;});
+
+		std::exception_ptr Exception = this->Exception;
+		this->Exception = nullptr;
+		this->Task = nullptr;
+		this->Busy = false;
+		Lock.unlock();
+		this->DoneCondition.notify_all();
+
+		if(Exception)
+			std::rethrow_exception(Exception);
+	}
+
+	inline void executor_thread_pool::run_ranges(std::unique_lock<std::mutex>& Lock)
+	{
+		bool& InTask = detail::in_executor_task();
+		bool const WasInTask = InTask;
+		InTask = true;
+
+		// Storages allocated by the tasks are tagged like the ones of the thread calling parallel_for
+		size_t& MemoryTag = detail::current_memory_tag();
+		size_t const PreviousMemoryTag = MemoryTag;
+		MemoryTag = this->MemoryTag;
+
+		while(this->Task && this->Next < this->Count)
+		{
+			size_t const Begin = this->Next;
+			size_t const End = std::min(Begin + this->Grain, this->Count);
+			this->Next = End;
+
+			// Once a range failed, the remaining ones are skipped
+			task_type const* Task = this->Exception ? nullptr : this->Task;
+
+			Lock.unlock();
+			std::exception_ptr Exception;
+			if(Task)
+			{
+				try
+				{
+					(*Task)(Begin, End);
+				}
+				catch(...)
+				{
+					Exception = std::current_exception();
+				}
+			}
+			Lock.lock();
+
+			if(Exception && !this->Exception)
+				this->Exception = Exception;
+
+			this->Done += End - Begin;
+			if(this->Done == this->Count)
+				this->DoneCondition.notify_all();
+		}
+
+		MemoryTag = PreviousMemoryTag;
+		InTask = WasInTask;
+	}
+
+	inline void executor_thread_pool::run_worker()
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		for(;;)
+		{
+			this->WorkCondition.wait(Lock, [this]{return this->Stop || (this->Task && this->Next < this->Count);});
+			if(this->Stop)
+				return;
+
+			this->run_ranges(Lock);
+		}
+	}
+
+	inline std::shared_ptr<executor> const& default_executor()
+	{
+		return detail::default_executor_instance();
+	}
+
+	inline void set_default_executor(std::shared_ptr<executor> const& Executor)
+	{
+		detail::default_executor_instance() = Executor ? Executor : std::make_shared<executor_sequential>();
+	}
+}//namespace gli
@@ -3,12 +3,98 @@
 
 #pragma once
 
+#include "../texture.hpp"
 #include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace gli{
+
+	/// Function writing Size bytes at Data to a file or a stream, returns false if it fails.
+	typedef std::function<bool(void const* Data, std::size_t Size)> write_func;
+
 namespace detail
 {
 	FILE* open_file(const char *Filename, const char *mode);
+
+	/// Pieces of a file written in order, either referencing memory that must outlive the list,
+	/// such as the images of a texture, or copied in the list, such as headers.
+	class write_list
+	{
+	public:
+		write_list();
+
+		/// Reference Size bytes at Data, written as they are when the list is written.
+		void append(void const* Data, std::size_t Size);
+
+		/// Copy Size bytes at Data in the list, zeros if Data is null.
+		void append_copy(void const* Data, std::size_t Size);
+
+		/// Return the number of bytes of the list.
+		std::size_t size() const;
+
+		/// Write the list in Memory, resized to the size of the list.
+		bool write(std::vector<char>& Memory) const;
+
+		/// Write the list at the current position of File.
+		bool write(FILE* File) const;
+
+		/// Write the list at the current position of FileDescriptor, the pieces gathered with writev where available.
+		bool write(int FileDescriptor) const;
+
+		/// Write the list by calling Write with each piece.
+		bool write(write_func const& Write) const;
+
+	private:
+		struct piece
+		{
+			char const* Data;
+			std::size_t Offset;
+			std::size_t Size;
+		};
+
+		char const* data(piece const& Piece) const;
+
+		std::vector<piece> Pieces;
+		std::vector<char> Copies;
+		std::size_t Size;
+	};
+
+	/// Map a whole file in memory, copy-on-write so the file itself is never modified.
+	/// Where mapping isn't available, the file is read into a heap buffer instead.
+	/// Returns a null pointer if the file can't be opened or is empty.
+	std::shared_ptr<char> map_file(char const* Filename, std::size_t& Size);
+
+	/// Memory for a texture storage referencing the texels at Data inside the File buffer,
+	/// or a null pointer if File is null or Data isn't suitably aligned for Format.
+	std::shared_ptr<storage_linear::data_type> share_file_memory(std::shared_ptr<char> const& File, char const* Data, format Format);
+
+	/// Non-owning memory for a texture storage referencing Data, which must outlive the storage.
+	std::shared_ptr<storage_linear::data_type> borrow_memory(char const* Data);
+
+	/// Layers, faces and levels requested from a loader, all of them by default.
+	struct subresource_range
+	{
+		subresource_range();
+		subresource_range(
+			size_t BaseLayer, size_t MaxLayer,
+			size_t BaseFace, size_t MaxFace,
+			size_t BaseLevel, size_t MaxLevel);
+
+		/// Clamp the Max values to a texture of Layers, Faces and Levels, returns false if a range is then empty.
+		bool clamp(size_t Layers, size_t Faces, size_t Levels);
+
+		/// Whether the range covers all of a texture of Layers, Faces and Levels.
+		bool whole(size_t Layers, size_t Faces, size_t Levels) const;
+
+		size_t BaseLayer, MaxLayer;
+		size_t BaseFace, MaxFace;
+		size_t BaseLevel, MaxLevel;
+	};
+
+	/// Copy the images in Range of Source in a new texture, or return Source itself if KeepSource is true and Range covers all of it.
+	texture copy_subresources(texture const& Source, bool KeepSource, subresource_range Range);
 }//namespace detail
 }//namespace gli
 
@@ -1,6 +1,22 @@
 #pragma once
 
 #include <glm/simd/platform.h>
+#include <algorithm>
+#include <cstdint>
+
+#if GLM_PLATFORM & (GLM_PLATFORM_LINUX | GLM_PLATFORM_APPLE | GLM_PLATFORM_ANDROID | GLM_PLATFORM_UNIX)
+#	define GLI_USE_MMAP
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	include <sys/uio.h>
+#	include <cerrno>
+#	include <climits>
+#	define GLI_USE_WRITEV
+#elif GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+#	include <io.h>
+#endif
 
 namespace gli{
 namespace detail
@@ -15,5 +31,278 @@ namespace detail
 			return std::fopen(Filename, Mode);
 #		endif
 	}
+
+	inline write_list::write_list()
+		: Size(0)
+	{}
+
+	inline void write_list::append(void const* Data, std::size_t Size)
+	{
+		if(Size == 0)
+			return;
+
+		piece const Piece = {static_cast<char const*>(Data), 0, Size};
+		this->Pieces.push_back(Piece);
+		this->Size += Size;
+	}
+
+	inline void write_list::append_copy(void const* Data, std::size_t Size)
+	{
+		if(Size == 0)
+			return;
+
+		// Copies are referenced by offset as the buffer may grow
+		piece const Piece = {nullptr, this->Copies.size(), Size};
+		this->Pieces.push_back(Piece);
+		this->Size += Size;
+
+		if(Data)
+			this->Copies.insert(this->Copies.end(), static_cast<char const*>(Data), static_cast<char const*>(Data) + Size);
+		else
+			this->Copies.resize(this->Copies.size() + Size, 0);
+	}
+
+	inline std::size_t write_list::size() const
+	{
+		return this->Size;
+	}
+
+	inline char const* write_list::data(piece const& Piece) const
+	{
+		return Piece.Data ? Piece.Data : &this->Copies[0] + Piece.Offset;
+	}
+
+	inline bool write_list::write(std::vector<char>& Memory) const
+	{
+		Memory.resize(this->Size);
+
+		std::size_t Offset = 0;
+		for(std::size_t PieceIndex = 0; PieceIndex < this->Pieces.size(); ++PieceIndex)
+		{
+			std::memcpy(&Memory[0] + Offset, this->data(this->Pieces[PieceIndex]), this->Pieces[PieceIndex].Size);
+			Offset += this->Pieces[PieceIndex].Size;
+		}
+
+		return true;
+	}
+
+	inline bool write_list::write(FILE* File) const
+	{
+		for(std::size_t PieceIndex = 0; PieceIndex < this->Pieces.size(); ++PieceIndex)
+		{
+			if(std::fwrite(this->data(this->Pieces[PieceIndex]), 1, this->Pieces[PieceIndex].Size, File) != this->Pieces[PieceIndex].Size)
+				return false;
+		}
+
+		return true;
+	}
+
+	inline bool write_list::write(int FileDescriptor) const
+	{
+#		ifdef GLI_USE_WRITEV
+			// Pieces are written by batches of at most IOV_MAX, resuming after partial writes
+			std::vector<iovec> Vectors(this->Pieces.size());
+			for(std::size_t PieceIndex = 0; PieceIndex < this->Pieces.size(); ++PieceIndex)
+			{
+				Vectors[PieceIndex].iov_base = const_cast<char*>(this->data(this->Pieces[PieceIndex]));
+				Vectors[PieceIndex].iov_len = this->Pieces[PieceIndex].Size;
+			}
+
+			std::size_t VectorIndex = 0;
+			while(VectorIndex < Vectors.size())
+			{
+				int const Count = static_cast<int>(std::min<std::size_t>(Vectors.size() - VectorIndex, IOV_MAX));
+				ssize_t Written = ::writev(FileDescriptor, &Vectors[VectorIndex], Count);
+				if(Written < 0)
+				{
+					if(errno == EINTR)
+						continue;
+					return false;
+				}
+
+				for(; VectorIndex < Vectors.size() && static_cast<std::size_t>(Written) >= Vectors[VectorIndex].iov_len; ++VectorIndex)
+					Written -= static_cast<ssize_t>(Vectors[VectorIndex].iov_len);
+
+				if(VectorIndex < Vectors.size())
+				{
+					Vectors[VectorIndex].iov_base = static_cast<char*>(Vectors[VectorIndex].iov_base) + Written;
+					Vectors[VectorIndex].iov_len -= static_cast<std::size_t>(Written);
+				}
+			}
+
+			return true;
+#		elif GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return this->write([FileDescriptor](void const* Data, std::size_t Size) -> bool
+			{
+				char const* Bytes = static_cast<char const*>(Data);
+				while(Size > 0)
+				{
+					int const Written = ::_write(FileDescriptor, Bytes, static_cast<unsigned int>(std::min<std::size_t>(Size, 1 << 30)));
+					if(Written <= 0)
+						return false;
+					Bytes += Written;
+					Size -= static_cast<std::size_t>(Written);
+				}
+				return true;
+			});
+#		else
+			return false;
+#		endif//GLI_USE_WRITEV
+	}
+
+	inline bool write_list::write(write_func const& Write) const
+	{
+		for(std::size_t PieceIndex = 0; PieceIndex < this->Pieces.size(); ++PieceIndex)
+		{
+			if(!Write(this->data(this->Pieces[PieceIndex]), this->Pieces[PieceIndex].Size))
+				return false;
+		}
+
+		return true;
+	}
+
+	inline std::shared_ptr<char> map_file(char const* Filename, std::size_t& Size)
+	{
+		Size = 0;
+
+#		ifdef GLI_USE_MMAP
+		{
+			int const File = ::open(Filename, O_RDONLY);
+			if(File < 0)
+				return nullptr;
+
+			struct stat Stat;
+			if(::fstat(File, &Stat) != 0 || Stat.st_size <= 0)
+			{
+				::close(File);
+				return nullptr;
+			}
+
+			std::size_t const FileSize = static_cast<std::size_t>(Stat.st_size);
+			void* const Mapping = ::mmap(nullptr, FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0);
+			::close(File);
+
+			if(Mapping != MAP_FAILED)
+			{
+				Size = FileSize;
+				return std::shared_ptr<char>(static_cast<char*>(Mapping), [FileSize](char* Pointer)
+				{
+					::munmap(Pointer, FileSize);
+				});
+			}
+		}
+#		endif//GLI_USE_MMAP
+
+		FILE* File = detail::open_file(Filename, "rb");
+		if(!File)
+			return nullptr;
+
+		long Beg = std::ftell(File);
+		std::fseek(File, 0, SEEK_END);
+		long End = std::ftell(File);
+		std::fseek(File, 0, SEEK_SET);
+
+		if(End <= Beg)
+		{
+			std::fclose(File);
+			return nullptr;
+		}
+
+		std::size_t const FileSize = static_cast<std::size_t>(End - Beg);
+		std::shared_ptr<char> Data(new char[FileSize], std::default_delete<char[]>());
+
+		std::size_t const Read = std::fread(Data.get(), 1, FileSize, File);
+		std::fclose(File);
+
+		if(Read != FileSize)
+			return nullptr;
+
+		Size = FileSize;
+		return Data;
+	}
+
+	inline std::shared_ptr<storage_linear::data_type> share_file_memory(std::shared_ptr<char> const& File, char const* Data, format Format)
+	{
+		if(!File)
+			return nullptr;
+
+		// Texels are accessed through types as large as the block, up to 64 bits
+		std::size_t const BlockSize = block_size(Format);
+		std::size_t const Alignment = std::min<std::size_t>(BlockSize & (~BlockSize + 1), 8);
+		if(reinterpret_cast<std::uintptr_t>(Data) % Alignment != 0)
+			return nullptr;
+
+		return std::shared_ptr<storage_linear::data_type>(File, reinterpret_cast<storage_linear::data_type*>(const_cast<char*>(Data)));
+	}
+
+	inline std::shared_ptr<storage_linear::data_type> borrow_memory(char const* Data)
+	{
+		return std::shared_ptr<storage_linear::data_type>(std::shared_ptr<storage_linear::data_type>(), reinterpret_cast<storage_linear::data_type*>(const_cast<char*>(Data)));
+	}
+
+	inline subresource_range::subresource_range()
+		: BaseLayer(0), MaxLayer(~size_t(0))
+		, BaseFace(0), MaxFace(~size_t(0))
+		, BaseLevel(0), MaxLevel(~size_t(0))
+	{}
+
+	inline subresource_range::subresource_range(
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel
+	)
+		: BaseLayer(BaseLayer), MaxLayer(MaxLayer)
+		, BaseFace(BaseFace), MaxFace(MaxFace)
+		, BaseLevel(BaseLevel), MaxLevel(MaxLevel)
+	{}
+
+	inline bool subresource_range::clamp(size_t Layers, size_t Faces, size_t Levels)
+	{
+		this->MaxLayer = std::min(this->MaxLayer, Layers - 1);
+		this->MaxFace = std::min(this->MaxFace, Faces - 1);
+		this->MaxLevel = std::min(this->MaxLevel, Levels - 1);
+
+		return this->BaseLayer <= this->MaxLayer && this->BaseFace <= this->MaxFace && this->BaseLevel <= this->MaxLevel;
+	}
+
+	inline bool subresource_range::whole(size_t Layers, size_t Faces, size_t Levels) const
+	{
+		return
+			this->BaseLayer == 0 && this->MaxLayer == Layers - 1 &&
+			this->BaseFace == 0 && this->MaxFace == Faces - 1 &&
+			this->BaseLevel == 0 && this->MaxLevel == Levels - 1;
+	}
+
+	inline texture copy_subresources(texture const& Source, bool KeepSource, subresource_range Range)
+	{
+		if(!Range.clamp(Source.layers(), Source.faces(), Source.levels()))
+			return texture();
+
+		if(KeepSource && Range.whole(Source.layers(), Source.faces(), Source.levels()))
+			return Source;
+
+		texture Texture(
+			Source.target(), Source.format(), Source.extent(Range.BaseLevel),
+			Range.MaxLayer - Range.BaseLayer + 1,
+			Range.MaxFace - Range.BaseFace + 1,
+			Range.MaxLevel - Range.BaseLevel + 1,
+			default_allocator(), STORAGE_INIT_NONE);
+
+		// The levels of a face are contiguous in both textures
+		size_t LevelsSize = 0;
+		for(size_t Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
+			LevelsSize += Texture.size(Level);
+
+		for(size_t Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
+		for(size_t Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
+			std::memcpy(Texture.data(Layer, Face, 0), Source.data(Range.BaseLayer + Layer, Range.BaseFace + Face, Range.BaseLevel), LevelsSize);
+
+		return Texture;
+	}
 }//namespace detail
 }//namespace gli
+
+// Platform selection private to this file
+#ifdef GLI_USE_WRITEV
+#	undef GLI_USE_WRITEV
+#endif
@@ -0,0 +1,529 @@
+/// @brief Batched filtering used by the samplers texture_lod overloads taking arrays of sample coordinates
+/// @file gli/core/filter_batch.hpp
+
+#pragma once
+
+#include "filter_compute.hpp"
+#include "convert_bulk.hpp"
+#include "../sampler.hpp"
+#include <type_traits>
+#include <cstring>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	// Samples are processed by batches. The coordinates of a batch are stored by components so that wrapping and
+	// the filter weights are computed for several samples at once. Texels are then fetched and blended sample per
+	// sample with the same operations, in the same order, as the filters of filter_compute.hpp so that the results
+	// match texture_lod called for each sample.
+	enum
+	{
+		SAMPLE_BATCH_SIZE = 8,
+		SAMPLE_BATCH_LEVELS = 32
+	};
+
+	template <typename T>
+	struct batch_axis
+	{
+		int Floor[SAMPLE_BATCH_SIZE];
+		int Ceil[SAMPLE_BATCH_SIZE];
+		T Blend[SAMPLE_BATCH_SIZE];
+		int UseFloor[SAMPLE_BATCH_SIZE];
+		int UseCeil[SAMPLE_BATCH_SIZE];
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		// Exact floor and ceil with SSE2 only. Floats of magnitude at least 2^23 and NaN are returned unchanged,
+		// the sign is restored so that -0 and the results in ]-1, 0] are negative zeros as with std::floor and std::ceil.
+		inline __m128 floor_ps(__m128 Value)
+		{
+			__m128 const SignMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+			__m128 const Small = _mm_cmplt_ps(_mm_andnot_ps(SignMask, Value), _mm_set1_ps(8388608.0f));
+			__m128 const Truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(Value));
+			__m128 const Floor = _mm_sub_ps(Truncated, _mm_and_ps(_mm_cmpgt_ps(Truncated, Value), _mm_set1_ps(1.0f)));
+			__m128 const Signed = _mm_or_ps(Floor, _mm_and_ps(Value, SignMask));
+			return _mm_or_ps(_mm_and_ps(Small, Signed), _mm_andnot_ps(Small, Value));
+		}
+
+		inline __m128 ceil_ps(__m128 Value)
+		{
+			__m128 const SignMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+			__m128 const Small = _mm_cmplt_ps(_mm_andnot_ps(SignMask, Value), _mm_set1_ps(8388608.0f));
+			__m128 const Truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(Value));
+			__m128 const Ceil = _mm_add_ps(Truncated, _mm_and_ps(_mm_cmplt_ps(Truncated, Value), _mm_set1_ps(1.0f)));
+			__m128 const Signed = _mm_or_ps(Ceil, _mm_and_ps(Value, SignMask));
+			return _mm_or_ps(_mm_and_ps(Small, Signed), _mm_andnot_ps(Small, Value));
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// Wrap Count coordinates of a component, as the sampler wrap functions
+	template <typename T>
+	inline void wrap_batch(wrap Wrap, T* Coords, size_t Count, size_t First = 0)
+	{
+		switch(Wrap)
+		{
+		case WRAP_CLAMP_TO_EDGE:
+			for(size_t i = First; i < Count; ++i)
+				Coords[i] = glm::clamp(Coords[i]);
+			break;
+		case WRAP_CLAMP_TO_BORDER:
+			break;
+		case WRAP_REPEAT:
+			for(size_t i = First; i < Count; ++i)
+				Coords[i] = glm::repeat(Coords[i]);
+			break;
+		case WRAP_MIRROR_REPEAT:
+			for(size_t i = First; i < Count; ++i)
+				Coords[i] = glm::mirrorRepeat(Coords[i]);
+			break;
+		default:
+			for(size_t i = First; i < Count; ++i)
+				Coords[i] = glm::mirrorClamp(Coords[i]);
+			break;
+		}
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		inline void wrap_batch(wrap Wrap, float* Coords, size_t Count)
+		{
+			size_t i = 0;
+			if(Wrap == WRAP_CLAMP_TO_EDGE)
+			{
+				// Operands are ordered to return the same values as glm::clamp, including for NaN and -0
+				for(; i + 4 <= Count; i += 4)
+				{
+					__m128 const Coord = _mm_loadu_ps(Coords + i);
+					_mm_storeu_ps(Coords + i, _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), Coord)));
+				}
+			}
+			else if(Wrap == WRAP_REPEAT)
+			{
+				for(; i + 4 <= Count; i += 4)
+				{
+					__m128 const Coord = _mm_loadu_ps(Coords + i);
+					_mm_storeu_ps(Coords + i, _mm_sub_ps(Coord, floor_ps(Coord)));
+				}
+			}
+
+			wrap_batch<float>(Wrap, Coords, Count, i);
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// Texel coordinates and weights of linear filtering along one component, see make_coord_linear and make_coord_linear_border
+	template <typename T>
+	inline void linear_axis_batch(T const* Coords, int const* Extents, batch_axis<T>& Axis, size_t Count, bool Border, size_t First = 0)
+	{
+		for(size_t i = First; i < Count; ++i)
+		{
+			T const Scaled = Coords[i] * (static_cast<T>(Extents[i]) - static_cast<T>(1));
+			if(Border)
+			{
+				T const Floor = glm::floor(Scaled);
+				Axis.Blend[i] = Scaled - Floor;
+				Axis.Floor[i] = static_cast<int>(Floor);
+				Axis.Ceil[i] = static_cast<int>(glm::ceil(Scaled));
+				Axis.UseFloor[i] = Axis.Floor[i] >= 0 && Axis.Floor[i] <= Extents[i] - 1;
+				Axis.UseCeil[i] = Axis.Ceil[i] >= 0 && Axis.Ceil[i] <= Extents[i] - 1;
+			}
+			else
+			{
+				Axis.Floor[i] = static_cast<int>(Scaled);
+				Axis.Ceil[i] = static_cast<int>(Scaled + static_cast<T>(0.5));
+				Axis.Blend[i] = Scaled - static_cast<T>(Axis.Floor[i]);
+			}
+		}
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		inline void linear_axis_batch(float const* Coords, int const* Extents, batch_axis<float>& Axis, size_t Count, bool Border)
+		{
+			__m128i const One = _mm_set1_epi32(1);
+			__m128i const MinusOne = _mm_set1_epi32(-1);
+
+			size_t i = 0;
+			for(; i + 4 <= Count; i += 4)
+			{
+				__m128i const Extent = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Extents + i));
+				__m128 const Scaled = _mm_mul_ps(_mm_loadu_ps(Coords + i), _mm_sub_ps(_mm_cvtepi32_ps(Extent), _mm_set1_ps(1.0f)));
+
+				if(Border)
+				{
+					__m128 const Floor = floor_ps(Scaled);
+					__m128i const FloorInt = _mm_cvttps_epi32(Floor);
+					__m128i const CeilInt = _mm_cvttps_epi32(ceil_ps(Scaled));
+					_mm_storeu_ps(Axis.Blend + i, _mm_sub_ps(Scaled, Floor));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.Floor + i), FloorInt);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.Ceil + i), CeilInt);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.UseFloor + i), _mm_and_si128(One, _mm_and_si128(_mm_cmpgt_epi32(FloorInt, MinusOne), _mm_cmplt_epi32(FloorInt, Extent))));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.UseCeil + i), _mm_and_si128(One, _mm_and_si128(_mm_cmpgt_epi32(CeilInt, MinusOne), _mm_cmplt_epi32(CeilInt, Extent))));
+				}
+				else
+				{
+					__m128i const FloorInt = _mm_cvttps_epi32(Scaled);
+					_mm_storeu_ps(Axis.Blend + i, _mm_sub_ps(Scaled, _mm_cvtepi32_ps(FloorInt)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.Floor + i), FloorInt);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Axis.Ceil + i), _mm_cvttps_epi32(_mm_add_ps(Scaled, _mm_set1_ps(0.5f))));
+				}
+			}
+
+			linear_axis_batch<float>(Coords, Extents, Axis, Count, Border, i);
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// Texel coordinates of nearest filtering along one component, see nearest::call
+	template <typename T>
+	inline void nearest_axis_batch(T const* Coords, int const* Extents, batch_axis<T>& Axis, size_t Count, bool Border)
+	{
+		for(size_t i = 0; i < Count; ++i)
+		{
+			T const Scaled = Coords[i] * (static_cast<T>(Extents[i]) - static_cast<T>(1));
+			if(Border)
+			{
+				Axis.Floor[i] = static_cast<int>(glm::round(Scaled));
+				Axis.UseFloor[i] = Axis.Floor[i] >= 0 && Axis.Floor[i] <= Extents[i] - 1;
+			}
+			else
+				Axis.Floor[i] = static_cast<int>(Scaled + static_cast<T>(0.5));
+		}
+	}
+
+	GLI_FORCE_INLINE size_t batch_texel_offset(storage_layout Layout, extent2d const& Extent, extent2d const& Coord)
+	{
+		if(Layout == STORAGE_LAYOUT_TILED)
+			return tiled_image_offset(Coord, Extent);
+		return static_cast<size_t>(Coord.y) * static_cast<size_t>(Extent.x) + static_cast<size_t>(Coord.x);
+	}
+
+	GLI_FORCE_INLINE size_t batch_texel_offset(storage_layout Layout, extent3d const& Extent, extent3d const& Coord)
+	{
+		size_t const SliceOffset = static_cast<size_t>(Coord.z) * static_cast<size_t>(Extent.x) * static_cast<size_t>(Extent.y);
+		return SliceOffset + batch_texel_offset(Layout, extent2d(Extent), extent2d(Coord));
+	}
+
+	// Fetch texels through the sampler convert function
+	template <typename texture_type, typename fetch_type, typename texel_type>
+	struct batch_fetch_convert
+	{
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename texture_type::size_type size_type;
+
+		batch_fetch_convert(texture_type const& Texture, fetch_type Fetch, size_type Layer, size_type Face)
+			: Texture(Texture)
+			, Fetch(Fetch)
+			, Layer(Layer)
+			, Face(Face)
+		{}
+
+		texel_type operator()(extent_type const& TexelCoord, int Level) const
+		{
+			return this->Fetch(this->Texture, TexelCoord, this->Layer, this->Face, static_cast<size_type>(Level));
+		}
+
+		texture_type const& Texture;
+		fetch_type const Fetch;
+		size_type const Layer;
+		size_type const Face;
+	};
+
+	// Fetch texels decoding the memory of the texture directly, the format being resolved once for the batch
+	template <typename texture_type, typename codec, typename texel_type>
+	struct batch_fetch_codec
+	{
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename texture_type::size_type size_type;
+		typedef typename codec::texel_type data_type;
+
+		batch_fetch_codec(texture_type const& Texture, size_type Layer, size_type Face)
+			: Layout(Texture.layout())
+		{
+			GLI_ASSERT(Texture.levels() <= SAMPLE_BATCH_LEVELS);
+			GLI_ASSERT(block_size(Texture.format()) == sizeof(data_type));
+
+			for(size_type Level = 0; Level < Texture.levels(); ++Level)
+			{
+				this->Data[Level] = static_cast<u8 const*>(Texture.texture::data(Layer, Face, Level));
+				this->Extent[Level] = Texture.extent(Level);
+			}
+		}
+
+		GLI_FORCE_INLINE texel_type operator()(extent_type const& TexelCoord, int Level) const
+		{
+			GLI_ASSERT(all(lessThan(TexelCoord, this->Extent[Level])));
+
+			data_type Texel;
+			std::memcpy(&Texel, this->Data[Level] + batch_texel_offset(this->Layout, this->Extent[Level], TexelCoord) * sizeof(data_type), sizeof(data_type));
+			return texel_type(codec::fetch(Texel));
+		}
+
+		storage_layout const Layout;
+		u8 const* Data[SAMPLE_BATCH_LEVELS];
+		extent_type Extent[SAMPLE_BATCH_LEVELS];
+	};
+
+	// Same operations as glm::mix, kept inline so that texels stay in registers
+	template <typename texel_type, typename T>
+	GLI_FORCE_INLINE texel_type mix_batch(texel_type const& x, texel_type const& y, T a)
+	{
+		return mix(x, y, a);
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		template <qualifier P>
+		GLI_FORCE_INLINE vec<4, float, P> mix_batch(vec<4, float, P> const& x, vec<4, float, P> const& y, float a)
+		{
+			__m128 const X = _mm_loadu_ps(&x[0]);
+			__m128 const Y = _mm_loadu_ps(&y[0]);
+
+			vec<4, float, P> Result;
+			_mm_storeu_ps(&Result[0], _mm_add_ps(X, _mm_mul_ps(_mm_set1_ps(a), _mm_sub_ps(Y, X))));
+			return Result;
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	template <length_t L, typename T, typename texel_type, typename fetch_type>
+	struct blend_batch
+	{};
+
+	template <typename T, typename texel_type, typename fetch_type>
+	struct blend_batch<2, T, texel_type, fetch_type>
+	{
+		typedef extent2d extent_type;
+
+		static GLI_FORCE_INLINE texel_type nearest(fetch_type const& Fetch, batch_axis<T> const* Axes, size_t i, int Level, bool Border, texel_type const& BorderColor)
+		{
+			if(Border && !(Axes[0].UseFloor[i] && Axes[1].UseFloor[i]))
+				return BorderColor;
+			return Fetch(extent_type(Axes[0].Floor[i], Axes[1].Floor[i]), Level);
+		}
+
+		static GLI_FORCE_INLINE texel_type linear(fetch_type const& Fetch, batch_axis<T> const* Axes, size_t i, int Level, bool Border, texel_type const& BorderColor)
+		{
+			batch_axis<T> const& S = Axes[0];
+			batch_axis<T> const& R = Axes[1];
+
+			texel_type Texel00(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseFloor[i]))
+				Texel00 = Fetch(extent_type(S.Floor[i], R.Floor[i]), Level);
+
+			texel_type Texel10(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseFloor[i]))
+				Texel10 = Fetch(extent_type(S.Ceil[i], R.Floor[i]), Level);
+
+			texel_type Texel11(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseCeil[i]))
+				Texel11 = Fetch(extent_type(S.Ceil[i], R.Ceil[i]), Level);
+
+			texel_type Texel01(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseCeil[i]))
+				Texel01 = Fetch(extent_type(S.Floor[i], R.Ceil[i]), Level);
+
+			texel_type const ValueA(mix_batch(Texel00, Texel10, S.Blend[i]));
+			texel_type const ValueB(mix_batch(Texel01, Texel11, S.Blend[i]));
+			return mix_batch(ValueA, ValueB, R.Blend[i]);
+		}
+	};
+
+	template <typename T, typename texel_type, typename fetch_type>
+	struct blend_batch<3, T, texel_type, fetch_type>
+	{
+		typedef extent3d extent_type;
+
+		static GLI_FORCE_INLINE texel_type nearest(fetch_type const& Fetch, batch_axis<T> const* Axes, size_t i, int Level, bool Border, texel_type const& BorderColor)
+		{
+			if(Border && !(Axes[0].UseFloor[i] && Axes[1].UseFloor[i] && Axes[2].UseFloor[i]))
+				return BorderColor;
+			return Fetch(extent_type(Axes[0].Floor[i], Axes[1].Floor[i], Axes[2].Floor[i]), Level);
+		}
+
+		static GLI_FORCE_INLINE texel_type linear(fetch_type const& Fetch, batch_axis<T> const* Axes, size_t i, int Level, bool Border, texel_type const& BorderColor)
+		{
+			batch_axis<T> const& S = Axes[0];
+			batch_axis<T> const& R = Axes[1];
+			batch_axis<T> const& Q = Axes[2];
+
+			texel_type Texel000(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseFloor[i] && Q.UseFloor[i]))
+				Texel000 = Fetch(extent_type(S.Floor[i], R.Floor[i], Q.Floor[i]), Level);
+
+			texel_type Texel100(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseFloor[i] && Q.UseFloor[i]))
+				Texel100 = Fetch(extent_type(S.Ceil[i], R.Floor[i], Q.Floor[i]), Level);
+
+			texel_type Texel110(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseCeil[i] && Q.UseFloor[i]))
+				Texel110 = Fetch(extent_type(S.Ceil[i], R.Ceil[i], Q.Floor[i]), Level);
+
+			texel_type Texel010(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseCeil[i] && Q.UseFloor[i]))
+				Texel010 = Fetch(extent_type(S.Floor[i], R.Ceil[i], Q.Floor[i]), Level);
+
+			texel_type Texel001(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseFloor[i] && Q.UseCeil[i]))
+				Texel001 = Fetch(extent_type(S.Floor[i], R.Floor[i], Q.Ceil[i]), Level);
+
+			texel_type Texel101(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseFloor[i] && Q.UseCeil[i]))
+				Texel101 = Fetch(extent_type(S.Ceil[i], R.Floor[i], Q.Ceil[i]), Level);
+
+			texel_type Texel111(BorderColor);
+			if(!Border || (S.UseCeil[i] && R.UseCeil[i] && Q.UseCeil[i]))
+				Texel111 = Fetch(extent_type(S.Ceil[i], R.Ceil[i], Q.Ceil[i]), Level);
+
+			texel_type Texel011(BorderColor);
+			if(!Border || (S.UseFloor[i] && R.UseCeil[i] && Q.UseCeil[i]))
+				Texel011 = Fetch(extent_type(S.Floor[i], R.Ceil[i], Q.Ceil[i]), Level);
+
+			texel_type const ValueA(mix_batch(Texel000, Texel100, S.Blend[i]));
+			texel_type const ValueB(mix_batch(Texel010, Texel110, S.Blend[i]));
+
+			texel_type const ValueC(mix_batch(Texel001, Texel101, S.Blend[i]));
+			texel_type const ValueD(mix_batch(Texel011, Texel111, S.Blend[i]));
+
+			texel_type const ValueE(mix_batch(ValueA, ValueB, R.Blend[i]));
+			texel_type const ValueF(mix_batch(ValueC, ValueD, R.Blend[i]));
+
+			return mix_batch(ValueE, ValueF, Q.Blend[i]);
+		}
+	};
+
+	template <typename texture_type, length_t L, typename interpolate_type, qualifier P, typename texel_type>
+	struct sample_batch
+	{
+		typedef vec<L, interpolate_type, P> normalized_type;
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename texture_type::size_type size_type;
+
+		// Filter the Count samples of a batch at the Levels of the samples, the coordinates being wrapped already
+		template <typename fetch_type>
+		static void filter_level
+		(
+			fetch_type const& Fetch, extent_type const* LevelExtents, filter Min, bool Border, texel_type const& BorderColor,
+			interpolate_type const (&Coords)[L][SAMPLE_BATCH_SIZE], int const* Levels,
+			texel_type* Texels, size_t Count
+		)
+		{
+			typedef blend_batch<L, interpolate_type, texel_type, fetch_type> blend;
+
+			batch_axis<interpolate_type> Axes[L];
+			for(length_t Component = 0; Component < L; ++Component)
+			{
+				int Extents[SAMPLE_BATCH_SIZE];
+				for(size_t i = 0; i < Count; ++i)
+					Extents[i] = LevelExtents[Levels[i]][Component];
+
+				if(Min == FILTER_LINEAR)
+					linear_axis_batch(Coords[Component], Extents, Axes[Component], Count, Border);
+				else
+					nearest_axis_batch(Coords[Component], Extents, Axes[Component], Count, Border);
+			}
+
+			if(Min == FILTER_LINEAR)
+			{
+				for(size_t i = 0; i < Count; ++i)
+					Texels[i] = blend::linear(Fetch, Axes, i, Levels[i], Border, BorderColor);
+			}
+			else
+			{
+				for(size_t i = 0; i < Count; ++i)
+					Texels[i] = blend::nearest(Fetch, Axes, i, Levels[i], Border, BorderColor);
+			}
+		}
+
+		template <typename fetch_type>
+		static void call
+		(
+			texture_type const& Texture, fetch_type const& Fetch, wrap Wrap, filter Mip, filter Min, texel_type const& BorderColor,
+			normalized_type const* SampleCoords, interpolate_type const* SampleLevels, texel_type* Texels, size_t Count
+		)
+		{
+			GLI_ASSERT(Texture.levels() <= SAMPLE_BATCH_LEVELS);
+
+			extent_type LevelExtents[SAMPLE_BATCH_LEVELS];
+			for(size_type Level = 0; Level < Texture.levels(); ++Level)
+				LevelExtents[Level] = Texture.extent(Level);
+
+			bool const Border = is_border(Wrap);
+
+			for(size_t BatchOffset = 0; BatchOffset < Count; BatchOffset += SAMPLE_BATCH_SIZE)
+			{
+				size_t const BatchCount = std::min<size_t>(SAMPLE_BATCH_SIZE, Count - BatchOffset);
+
+				interpolate_type Coords[L][SAMPLE_BATCH_SIZE];
+				for(length_t Component = 0; Component < L; ++Component)
+				{
+					for(size_t i = 0; i < BatchCount; ++i)
+						Coords[Component][i] = SampleCoords[BatchOffset + i][Component];
+					wrap_batch(Wrap, Coords[Component], BatchCount);
+				}
+
+				if(Mip == FILTER_LINEAR)
+				{
+					int FloorLevels[SAMPLE_BATCH_SIZE];
+					int CeilLevels[SAMPLE_BATCH_SIZE];
+					for(size_t i = 0; i < BatchCount; ++i)
+					{
+						FloorLevels[i] = static_cast<int>(glm::floor(SampleLevels[BatchOffset + i]));
+						CeilLevels[i] = static_cast<int>(glm::ceil(SampleLevels[BatchOffset + i]));
+					}
+
+					texel_type MinTexels[SAMPLE_BATCH_SIZE];
+					texel_type MaxTexels[SAMPLE_BATCH_SIZE];
+					filter_level(Fetch, LevelExtents, Min, Border, BorderColor, Coords, FloorLevels, MinTexels, BatchCount);
+					filter_level(Fetch, LevelExtents, Min, Border, BorderColor, Coords, CeilLevels, MaxTexels, BatchCount);
+
+					for(size_t i = 0; i < BatchCount; ++i)
+						Texels[BatchOffset + i] = mix_batch(MinTexels[i], MaxTexels[i], glm::fract(SampleLevels[BatchOffset + i]));
+				}
+				else
+				{
+					int Levels[SAMPLE_BATCH_SIZE];
+					for(size_t i = 0; i < BatchCount; ++i)
+						Levels[i] = glm::iround(SampleLevels[BatchOffset + i]);
+
+					filter_level(Fetch, LevelExtents, Min, Border, BorderColor, Coords, Levels, Texels + BatchOffset, BatchCount);
+				}
+			}
+		}
+	};
+
+	// Resolve how texels are decoded once for all the samples: float samplers decode the formats of the bulk
+	// conversion codecs directly from memory, other formats and samplers go through the sampler convert function.
+	template <typename texture_type, length_t L, typename interpolate_type, qualifier P, typename texel_type, typename fetch_type>
+	inline void texture_lod_batch
+	(
+		texture_type const& Texture, fetch_type Fetch, wrap Wrap, filter Mip, filter Min, texel_type const& BorderColor,
+		typename texture_type::size_type Layer, typename texture_type::size_type Face,
+		vec<L, interpolate_type, P> const* SampleCoords, interpolate_type const* SampleLevels, texel_type* Texels, size_t Count
+	)
+	{
+		typedef sample_batch<texture_type, L, interpolate_type, P, texel_type> sample;
+
+		if(std::is_same<typename texel_type::value_type, float>::value)
+		{
+			switch(find_bulk_codec(Texture.format()))
+			{
+			case BULK_CODEC_NORM8_3:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_norm8<3>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			case BULK_CODEC_NORM8_4:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_norm8<4>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			case BULK_CODEC_SRGB8_3:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_srgb8<3>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			case BULK_CODEC_SRGB8_4:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_srgb8<4>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			case BULK_CODEC_HALF_4:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_half<4>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			case BULK_CODEC_FLOAT_4:
+				return sample::call(Texture, batch_fetch_codec<texture_type, codec_float<4>, texel_type>(Texture, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+			default:
+				break;
+			}
+		}
+
+		sample::call(Texture, batch_fetch_convert<texture_type, fetch_type, texel_type>(Texture, Fetch, Layer, Face), Wrap, Mip, Min, BorderColor, SampleCoords, SampleLevels, Texels, Count);
+	}
+}//namespace detail
+}//namespace gli
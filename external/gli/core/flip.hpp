@@ -6,12 +6,18 @@
 #include "../texture2d_array.hpp"
 #include "../texture_cube.hpp"
 #include "../texture_cube_array.hpp"
+#include "../execution.hpp"
+#include "../layout.hpp"
 
 namespace gli
 {
 	template <typename texture>
 	texture flip(texture const & Texture);
 
+	/// Flip the images of a 2d, 2d array, cube or cube array texture vertically without allocating memory.
+	/// The storage is shared by all the copies of the texture, they are all flipped.
+	void flip_in_place(texture& Texture);
+
 }//namespace gli
 
 #include "flip.inl"
@@ -3,23 +3,7 @@
 namespace gli{
 namespace detail
 {
-	inline void flip(image ImageDst, image ImageSrc, size_t BlockSize)
-	{
-		size_t const LineSize = BlockSize * ImageDst.extent().x;
-
-		for(int y = 0; y < ImageDst.extent().y; ++y)
-		{
-			size_t OffsetDst = LineSize * y;
-			size_t OffsetSrc = ImageSrc.size() - (LineSize * (y + 1));
-
-			memcpy(
-				ImageDst.data<glm::byte>() + OffsetDst,
-				ImageSrc.data<glm::byte>() + OffsetSrc,
-				LineSize);
-		}
-	}
-
-	inline void flip_block_s3tc(uint8_t* BlockDst, uint8_t* BlockSrc, format Format, bool HeightTwo)
+	inline void flip_block_s3tc(uint8_t* BlockDst, uint8_t const* BlockSrc, format Format, bool HeightTwo)
 	{
 		// There is no distinction between RGB and RGBA in DXT-compressed textures,
 		// it is used only to tell OpenGL how to interpret the data.
@@ -30,7 +14,7 @@ namespace detail
 		if(Format == FORMAT_RGB_DXT1_UNORM_BLOCK8 || Format == FORMAT_RGB_DXT1_SRGB_BLOCK8
 		|| Format == FORMAT_RGBA_DXT1_UNORM_BLOCK8 || Format == FORMAT_RGBA_DXT1_SRGB_BLOCK8)
 		{
-			dxt1_block* Src = reinterpret_cast<dxt1_block*>(BlockSrc);
+			dxt1_block const* Src = reinterpret_cast<dxt1_block const*>(BlockSrc);
 			dxt1_block* Dst = reinterpret_cast<dxt1_block*>(BlockDst);
 
 			if(HeightTwo)
@@ -58,7 +42,7 @@ namespace detail
 		// DXT3
 		if(Format == FORMAT_RGBA_DXT3_UNORM_BLOCK16 || Format == FORMAT_RGBA_DXT3_SRGB_BLOCK16)
 		{
-			dxt3_block* Src = reinterpret_cast<dxt3_block*>(BlockSrc);
+			dxt3_block const* Src = reinterpret_cast<dxt3_block const*>(BlockSrc);
 			dxt3_block* Dst = reinterpret_cast<dxt3_block*>(BlockDst);
 
 			if(HeightTwo)
@@ -94,7 +78,7 @@ namespace detail
 		// DXT5
 		if(Format == FORMAT_RGBA_DXT5_UNORM_BLOCK16 || Format == FORMAT_RGBA_DXT5_SRGB_BLOCK16)
 		{
-			dxt5_block* Src = reinterpret_cast<dxt5_block*>(BlockSrc);
+			dxt5_block const* Src = reinterpret_cast<dxt5_block const*>(BlockSrc);
 			dxt5_block* Dst = reinterpret_cast<dxt5_block*>(BlockDst);
 
 			if(HeightTwo)
@@ -145,31 +129,206 @@ namespace detail
 		assert(false);
 	}
 
-	inline void flip_s3tc(image ImageDst, image ImageSrc, format Format)
+	inline void flip_s3tc(uint8_t* DataDst, uint8_t const* DataSrc, size_t Size, texture::extent_type const& Extent, format Format)
 	{
-		if(ImageSrc.extent().y == 1)
+		if(Extent.y == 1)
 		{
-			memcpy(ImageDst.data(),
-				   ImageSrc.data(),
-				   ImageSrc.size());
+			memcpy(DataDst, DataSrc, Size);
 			return;
 		}
 
-		std::size_t const XBlocks = ImageSrc.extent().x <= 4 ? 1 : ImageSrc.extent().x / 4;
-		if(ImageSrc.extent().y == 2)
+		std::size_t const XBlocks = Extent.x <= 4 ? 1 : Extent.x / 4;
+		if(Extent.y == 2)
 		{
 			for(std::size_t i_block = 0; i_block < XBlocks; ++i_block)
-				flip_block_s3tc(ImageDst.data<uint8_t>() + i_block * block_size(Format), ImageSrc.data<uint8_t>() + i_block * block_size(Format), Format, true);
+				flip_block_s3tc(DataDst + i_block * block_size(Format), DataSrc + i_block * block_size(Format), Format, true);
 
 			return;
 		}
 
-		std::size_t const MaxYBlock = ImageSrc.extent().y / 4 - 1;
+		std::size_t const MaxYBlock = Extent.y / 4 - 1;
 		for(std::size_t i_row = 0; i_row <= MaxYBlock; ++i_row)
 			for(std::size_t i_block = 0; i_block < XBlocks; ++i_block)
-				flip_block_s3tc(ImageDst.data<uint8_t>() + (MaxYBlock - i_row) * block_size(Format) * XBlocks + i_block * block_size(Format), ImageSrc.data<uint8_t>() + i_row * block_size(Format) * XBlocks + i_block * block_size(Format), Format, false);
+				flip_block_s3tc(DataDst + (MaxYBlock - i_row) * block_size(Format) * XBlocks + i_block * block_size(Format), DataSrc + i_row * block_size(Format) * XBlocks + i_block * block_size(Format), Format, false);
+	}
+
+	// Flip every image of TextureSrc into TextureDst with the default executor,
+	// uncompressed images by bands of rows, S3TC compressed images whole.
+	inline void flip_images(texture& TextureDst, texture const& TextureSrc)
+	{
+		if(!is_compressed(TextureSrc.format()))
+		{
+			size_t const BlockSize = block_size(TextureSrc.format());
+			storage_layout const LayoutDst = TextureDst.layout();
+			storage_layout const LayoutSrc = TextureSrc.layout();
+
+			for_each_image_band(split_image_bands(TextureSrc, 0, TextureSrc.layers() - 1, 0, TextureSrc.faces() - 1, 0, TextureSrc.levels() - 1), [&](image_band const& Band)
+			{
+				texture::extent_type const Extent(TextureSrc.extent(Band.Level));
+				size_t const LineSize = BlockSize * Extent.x;
+
+				glm::byte* DataDst = static_cast<glm::byte*>(TextureDst.data(Band.Layer, Band.Face, Band.Level));
+				glm::byte const* DataSrc = static_cast<glm::byte const*>(TextureSrc.data(Band.Layer, Band.Face, Band.Level));
+
+				if(LayoutDst == STORAGE_LAYOUT_LINEAR && LayoutSrc == STORAGE_LAYOUT_LINEAR)
+				{
+					for(int y = Band.Begin; y < Band.End; ++y)
+						memcpy(DataDst + LineSize * y, DataSrc + LineSize * (Extent.y - 1 - y), LineSize);
+					return;
+				}
+
+				// Rows of tiled images are contiguous by runs of the width of a tile
+				for(int y = Band.Begin; y < Band.End; ++y)
+				for(int x = 0; x < Extent.x; x += 4)
+				{
+					memcpy(
+						DataDst + layout_texel_offset(LayoutDst, Extent, x, y) * BlockSize,
+						DataSrc + layout_texel_offset(LayoutSrc, Extent, x, Extent.y - 1 - y) * BlockSize,
+						static_cast<size_t>(std::min(4, Extent.x - x)) * BlockSize);
+				}
+			});
+		}
+		else
+		{
+			size_t const Faces = TextureSrc.faces();
+			size_t const Levels = TextureSrc.levels();
+
+			default_executor()->parallel_for(TextureSrc.layers() * Faces * Levels, 1, [&](size_t Begin, size_t End)
+			{
+				for(size_t Index = Begin; Index < End; ++Index)
+				{
+					size_t const Layer = Index / (Faces * Levels);
+					size_t const Face = Index / Levels % Faces;
+					size_t const Level = Index % Levels;
+
+					flip_s3tc(
+						static_cast<uint8_t*>(TextureDst.data(Layer, Face, Level)),
+						static_cast<uint8_t const*>(TextureSrc.data(Layer, Face, Level)),
+						TextureSrc.size(Level), TextureSrc.extent(Level), TextureSrc.format());
+				}
+			});
+		}
+	}
+
+	// Swap two ranges of bytes through a bounce buffer on the stack
+	inline void swap_bytes(glm::byte* A, glm::byte* B, size_t Size)
+	{
+		glm::byte Bounce[256];
+		for(size_t Offset = 0; Offset < Size; Offset += sizeof(Bounce))
+		{
+			size_t const Count = std::min(Size - Offset, sizeof(Bounce));
+			memcpy(Bounce, A + Offset, Count);
+			memcpy(A + Offset, B + Offset, Count);
+			memcpy(B + Offset, Bounce, Count);
+		}
+	}
+
+	inline void flip_s3tc_in_place(uint8_t* Data, texture::extent_type const& Extent, format Format)
+	{
+		if(Extent.y == 1)
+			return;
+
+		std::size_t const BlockSize = block_size(Format);
+		std::size_t const XBlocks = Extent.x <= 4 ? 1 : Extent.x / 4;
+
+		// flip_block_s3tc doesn't support aliasing, the source blocks are copied first
+		uint8_t BlockA[16];
+		uint8_t BlockB[16];
+
+		if(Extent.y == 2)
+		{
+			for(std::size_t i_block = 0; i_block < XBlocks; ++i_block)
+			{
+				memcpy(BlockA, Data + i_block * BlockSize, BlockSize);
+				flip_block_s3tc(Data + i_block * BlockSize, BlockA, Format, true);
+			}
+
+			return;
+		}
+
+		std::size_t const YBlocks = Extent.y / 4;
+		for(std::size_t i_row = 0; i_row < (YBlocks + 1) / 2; ++i_row)
+		{
+			uint8_t* RowA = Data + i_row * BlockSize * XBlocks;
+			uint8_t* RowB = Data + (YBlocks - 1 - i_row) * BlockSize * XBlocks;
+
+			for(std::size_t i_block = 0; i_block < XBlocks; ++i_block)
+			{
+				memcpy(BlockA, RowA + i_block * BlockSize, BlockSize);
+				memcpy(BlockB, RowB + i_block * BlockSize, BlockSize);
+				flip_block_s3tc(RowA + i_block * BlockSize, BlockB, Format, false);
+				if(RowA != RowB)
+					flip_block_s3tc(RowB + i_block * BlockSize, BlockA, Format, false);
+			}
+		}
 	}
 
+	// Flip every image of Texture in place with the default executor, uncompressed images by
+	// bands of the upper half rows swapped with the lower half rows, S3TC compressed images whole.
+	inline void flip_images_in_place(texture& Texture)
+	{
+		// Memory shared for copy on write is copied once here rather than by the first band writing it while other bands read it
+		Texture.data();
+
+		if(!is_compressed(Texture.format()))
+		{
+			size_t const BlockSize = block_size(Texture.format());
+			storage_layout const Layout = Texture.layout();
+
+			std::vector<image_band> Bands;
+			{
+				std::vector<image_band> const ImageBands(split_image_bands(Texture, 0, Texture.layers() - 1, 0, Texture.faces() - 1, 0, Texture.levels() - 1));
+				for(size_t BandIndex = 0; BandIndex < ImageBands.size(); ++BandIndex)
+				{
+					image_band Band = ImageBands[BandIndex];
+					Band.End = std::min(Band.End, Texture.extent(Band.Level).y / 2);
+					if(Band.Begin < Band.End)
+						Bands.push_back(Band);
+				}
+			}
+
+			for_each_image_band(Bands, [&](image_band const& Band)
+			{
+				texture::extent_type const Extent(Texture.extent(Band.Level));
+				size_t const LineSize = BlockSize * Extent.x;
+
+				glm::byte* Data = static_cast<glm::byte*>(Texture.data(Band.Layer, Band.Face, Band.Level));
+
+				if(Layout == STORAGE_LAYOUT_LINEAR)
+				{
+					for(int y = Band.Begin; y < Band.End; ++y)
+						swap_bytes(Data + LineSize * y, Data + LineSize * (Extent.y - 1 - y), LineSize);
+					return;
+				}
+
+				for(int y = Band.Begin; y < Band.End; ++y)
+				for(int x = 0; x < Extent.x; x += 4)
+				{
+					swap_bytes(
+						Data + layout_texel_offset(Layout, Extent, x, y) * BlockSize,
+						Data + layout_texel_offset(Layout, Extent, x, Extent.y - 1 - y) * BlockSize,
+						static_cast<size_t>(std::min(4, Extent.x - x)) * BlockSize);
+				}
+			});
+		}
+		else
+		{
+			size_t const Faces = Texture.faces();
+			size_t const Levels = Texture.levels();
+
+			default_executor()->parallel_for(Texture.layers() * Faces * Levels, 1, [&](size_t Begin, size_t End)
+			{
+				for(size_t Index = Begin; Index < End; ++Index)
+				{
+					size_t const Layer = Index / (Faces * Levels);
+					size_t const Face = Index / Levels % Faces;
+					size_t const Level = Index % Levels;
+
+					flip_s3tc_in_place(static_cast<uint8_t*>(Texture.data(Layer, Face, Level)), Texture.extent(Level), Texture.format());
+				}
+			});
+		}
+	}
 }//namespace detail
 
 /*
@@ -185,18 +344,9 @@ inline texture2d flip(texture2d const& Texture)
 {
 	GLI_ASSERT(!gli::is_compressed(Texture.format()) || gli::is_s3tc_compressed(Texture.format()));
 
-	texture2d Flip(Texture.format(), Texture.extent(), Texture.levels());
+	texture2d Flip(detail::make_texture(TARGET_2D, Texture.format(), Texture.texture::extent(), 1, 1, Texture.levels(), Texture.layout()));
 
-	if(!is_compressed(Texture.format()))
-	{
-		texture2d::size_type const BlockSize = block_size(Texture.format());
-
-		for(texture2d::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip(Flip[Level], Texture[Level], BlockSize);
-	}
-	else
-		for(texture2d::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip_s3tc(Flip[Level], Texture[Level], Texture.format());
+	detail::flip_images(Flip, Texture);
 
 	return Flip;
 }
@@ -206,20 +356,9 @@ inline texture2d_array flip(texture2d_array const& Texture)
 {
 	GLI_ASSERT(!gli::is_compressed(Texture.format()) || gli::is_s3tc_compressed(Texture.format()));
 
-	texture2d_array Flip(Texture.format(), Texture.extent(), Texture.layers(), Texture.levels());
+	texture2d_array Flip(detail::make_texture(TARGET_2D_ARRAY, Texture.format(), Texture.texture::extent(), Texture.layers(), 1, Texture.levels(), Texture.layout()));
 
-	if(!gli::is_compressed(Texture.format()))
-	{
-		texture2d_array::size_type const BlockSize = block_size(Texture.format());
-
-		for(texture2d_array::size_type Layer = 0; Layer < Flip.layers(); ++Layer)
-		for(texture2d_array::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip(Flip[Layer][Level], Texture[Layer][Level], BlockSize);
-	}
-	else
-		for(texture2d_array::size_type Layer = 0; Layer < Flip.layers(); ++Layer)
-		for(texture2d_array::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip_s3tc(Flip[Layer][Level], Texture[Layer][Level], Texture.format());
+	detail::flip_images(Flip, Texture);
 
 	return Flip;
 }
@@ -229,20 +368,9 @@ inline texture_cube flip(texture_cube const & Texture)
 {
 	GLI_ASSERT(!gli::is_compressed(Texture.format()) || gli::is_s3tc_compressed(Texture.format()));
 
-	texture_cube Flip(Texture.format(), Texture.extent(), Texture.levels());
-
-	if(!gli::is_compressed(Texture.format()))
-	{
-		texture_cube::size_type const BlockSize = block_size(Texture.format());
+	texture_cube Flip(detail::make_texture(TARGET_CUBE, Texture.format(), Texture.texture::extent(), 1, Texture.faces(), Texture.levels(), Texture.layout()));
 
-		for(texture_cube::size_type Face = 0; Face < Flip.faces(); ++Face)
-		for(texture_cube::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip(Flip[Face][Level], Texture[Face][Level], BlockSize);
-	}
-	else
-		for(texture_cube::size_type Face = 0; Face < Flip.faces(); ++Face)
-		for(texture_cube::size_type Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip_s3tc(Flip[Face][Level], Texture[Face][Level], Texture.format());
+	detail::flip_images(Flip, Texture);
 
 	return Flip;
 }
@@ -252,22 +380,9 @@ inline texture_cube_array flip(texture_cube_array const & Texture)
 {
 	assert(!is_compressed(Texture.format()) || is_s3tc_compressed(Texture.format()));
 
-	texture_cube_array Flip(Texture.format(), Texture.extent(), Texture.layers(), Texture.levels());
+	texture_cube_array Flip(detail::make_texture(TARGET_CUBE_ARRAY, Texture.format(), Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.layout()));
 
-	if(!is_compressed(Texture.format()))
-	{
-		gli::size_t const BlockSize = block_size(Texture.format());
-
-		for(std::size_t Layer = 0; Layer < Flip.layers(); ++Layer)
-		for(std::size_t Face = 0; Face < Flip.faces(); ++Face)
-		for(std::size_t Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip(Flip[Layer][Face][Level], Texture[Layer][Face][Level], BlockSize);
-	}
-	else
-		for(std::size_t Layer = 0; Layer < Flip.layers(); ++Layer)
-		for(std::size_t Face = 0; Face < Flip.faces(); ++Face)
-		for(std::size_t Level = 0; Level < Flip.levels(); ++Level)
-			detail::flip_s3tc(Flip[Layer][Face][Level], Texture[Layer][Face][Level], Texture.format());
+	detail::flip_images(Flip, Texture);
 
 	return Flip;
 }
@@ -295,4 +410,13 @@ inline texture flip(texture const & Texture)
 	}
 }
 
+inline void flip_in_place(texture& Texture)
+{
+	GLI_ASSERT(!Texture.empty());
+	GLI_ASSERT(Texture.target() == TARGET_2D || Texture.target() == TARGET_2D_ARRAY || Texture.target() == TARGET_CUBE || Texture.target() == TARGET_CUBE_ARRAY);
+	GLI_ASSERT(!is_compressed(Texture.format()) || is_s3tc_compressed(Texture.format()));
+
+	detail::flip_images_in_place(Texture);
+}
+
 }//namespace gli
@@ -5,6 +5,7 @@
 #include "../sampler3d.hpp"
 #include "../sampler_cube.hpp"
 #include "../sampler_cube_array.hpp"
+#include "./mipmaps_box.hpp"
 
 namespace gli
 {
@@ -124,4 +125,68 @@ namespace gli
 	{
 		return generate_mipmaps(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), Minification);
 	}
+
+	inline texture2d generate_mipmaps_box(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel)
+	{
+		texture2d Result(Texture);
+		detail::generate_mipmaps_box(Result, 0, 0, 0, 0, BaseLevel, MaxLevel);
+		return Result;
+	}
+
+	inline texture2d_array generate_mipmaps_box(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel)
+	{
+		texture2d_array Result(Texture);
+		detail::generate_mipmaps_box(Result, BaseLayer, MaxLayer, 0, 0, BaseLevel, MaxLevel);
+		return Result;
+	}
+
+	inline texture_cube generate_mipmaps_box(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel)
+	{
+		texture_cube Result(Texture);
+		detail::generate_mipmaps_box(Result, 0, 0, BaseFace, MaxFace, BaseLevel, MaxLevel);
+		return Result;
+	}
+
+	inline texture_cube_array generate_mipmaps_box(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel)
+	{
+		texture_cube_array Result(Texture);
+		detail::generate_mipmaps_box(Result, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel);
+		return Result;
+	}
+
+	template <>
+	inline texture2d generate_mipmaps_box<texture2d>(texture2d const& Texture)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_level(), Texture.max_level());
+	}
+
+	template <>
+	inline texture2d_array generate_mipmaps_box<texture2d_array>(texture2d_array const& Texture)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_level(), Texture.max_level());
+	}
+
+	template <>
+	inline texture_cube generate_mipmaps_box<texture_cube>(texture_cube const& Texture)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level());
+	}
+
+	template <>
+	inline texture_cube_array generate_mipmaps_box<texture_cube_array>(texture_cube_array const& Texture)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level());
+	}
 }//namespace gli
@@ -26,8 +26,7 @@ namespace detail
 	};
 }//namespace detail
 
-	inline gl::gl(profile Profile)
-		: Profile(Profile)
+	inline gl::profile_formats::profile_formats(profile Profile)
 	{
 		bool const HasSwizzle = has_swizzle(Profile);
 		external_format const ExternalBGR = HasSwizzle ? EXTERNAL_RGB : EXTERNAL_BGR;
@@ -302,8 +301,35 @@ namespace detail
 		static_assert(sizeof(Table) / sizeof(Table[0]) == FORMAT_COUNT, "GLI error: format descriptor list doesn't match number of supported formats");
 
 		std::copy(&Table[0], &Table[0] + FORMAT_COUNT, this->FormatDesc.begin());
+
+		// The first format of the table is found for OpenGL formats shared by several formats
+		for(int FormatIndex = FORMAT_FIRST; FormatIndex <= FORMAT_LAST; ++FormatIndex)
+		{
+			format_desc const& Desc = this->FormatDesc[FormatIndex - FORMAT_FIRST];
+			format_key const Key = {Desc.Internal, Desc.External, Desc.Type};
+			this->Formats.insert(std::make_pair(Key, static_cast<gli::format>(FormatIndex)));
+		}
 	}
 
+	inline gl::profile_formats const& gl::get_profile_formats(profile Profile)
+	{
+		static profile_formats const Formats[] =
+		{
+			profile_formats(PROFILE_ES20),
+			profile_formats(PROFILE_ES30),
+			profile_formats(PROFILE_GL32),
+			profile_formats(PROFILE_GL33),
+			profile_formats(PROFILE_KTX)
+		};
+
+		return Formats[Profile];
+	}
+
+	inline gl::gl(profile Profile)
+		: Formats(&get_profile_formats(Profile))
+		, Profile(Profile)
+	{}
+
 	inline gl::target const& gl::translate(gli::target Target) const
 	{
 		static gl::target const Table[] =
@@ -327,7 +353,7 @@ namespace detail
 	{
 		GLI_ASSERT(Format >= FORMAT_FIRST && Format <= FORMAT_LAST);
 
-		gl::format_desc const& FormatDesc = this->FormatDesc[Format - FORMAT_FIRST];
+		gl::format_desc const& FormatDesc = this->Formats->FormatDesc[Format - FORMAT_FIRST];
 
 		gl::format FormatGL;
 		FormatGL.Internal = FormatDesc.Internal;
@@ -337,21 +363,14 @@ namespace detail
 		return FormatGL;
 	}
 
-	inline gli::format gl::find(gl::internal_format InternalFormat, gl::external_format ExternalFormat, gl::type_format Type)
+	inline gli::format gl::find(gl::internal_format InternalFormat, gl::external_format ExternalFormat, gl::type_format Type) const
 	{
-		for(int FormatIndex = FORMAT_FIRST; FormatIndex <= FORMAT_LAST; ++FormatIndex)
-		{
-			std::size_t const Index = FormatIndex - FORMAT_FIRST;
-			if (this->FormatDesc[Index].Internal != InternalFormat)
-				continue;
-			if (this->FormatDesc[Index].External != ExternalFormat)
-				continue;
-			if (this->FormatDesc[Index].Type != Type)
-				continue;
-
-			return static_cast<gli::format>(FormatIndex);
-		}
-		return static_cast<gli::format>(FORMAT_INVALID);
+		format_key const Key = {InternalFormat, ExternalFormat, Type};
+
+		std::unordered_map<format_key, gli::format, format_key_hash>::const_iterator const it = this->Formats->Formats.find(Key);
+		if(it == this->Formats->Formats.end())
+			return static_cast<gli::format>(FORMAT_INVALID);
+		return it->second;
 	}
 
 	inline gl::swizzles gl::compute_swizzle(format_desc const& FormatDesc, gli::swizzles const& Swizzles) const
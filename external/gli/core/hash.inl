@@ -0,0 +1,42 @@
+namespace gli
+{
+	inline uint64 hash(texture const& Texture)
+	{
+		if(Texture.empty())
+			return 0;
+
+		size_t const Faces = Texture.faces();
+		size_t const Levels = Texture.levels();
+
+		// The images not hashed yet are hashed with the default executor
+		default_executor()->parallel_for(Texture.layers() * Faces * Levels, 1, [&](size_t Begin, size_t End)
+		{
+			for(size_t Index = Begin; Index < End; ++Index)
+				Texture.hash(Index / (Faces * Levels), Index / Levels % Faces, Index % Levels);
+		});
+
+		// Only what gli::equal compares is hashed
+		uint64 Hash = detail::hash_combine(0, static_cast<uint64>(Texture.target()));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Texture.format()));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Texture.layout()));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Texture.layers()));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Faces));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Levels));
+		Hash = detail::hash_combine(Hash, static_cast<uint64>(Texture.size()));
+
+		for(size_t Layer = 0, LayerCount = Texture.layers(); Layer < LayerCount; ++Layer)
+		for(size_t Face = 0; Face < Faces; ++Face)
+		for(size_t Level = 0; Level < Levels; ++Level)
+			Hash = detail::hash_combine(Hash, Texture.hash(Layer, Face, Level));
+
+		return Hash;
+	}
+}//namespace gli
+
+namespace std
+{
+	inline size_t hash<gli::texture>::operator()(gli::texture const& Texture) const
+	{
+		return static_cast<size_t>(gli::hash(Texture));
+	}
+}//namespace std
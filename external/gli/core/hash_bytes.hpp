@@ -0,0 +1,123 @@
+/// @brief Fast non-cryptographic 64 bits hash of memory, used to fingerprint the content of images
+/// @file gli/core/hash_bytes.hpp
+
+#pragma once
+
+#include "../type.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	// Data is read by stripes of 32 bytes accumulated in 4 lanes of 64 bits. Each lane adds the product of the 32 bits
+	// halves of the data xored with a key, the adjacent lane adds the data itself. Lanes are scrambled every 32 stripes.
+	// Only 32 bits multiplications producing 64 bits are used so that the SIMD path computes the same hashes.
+	static uint64 const HashKeys[3][4] =
+	{
+		{0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull},
+		{0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull},
+		{0xcb00c391bb52283cull, 0xa32e531b8b65d088ull, 0x4ef90da297486471ull, 0xd8acdea946ef1938ull}
+	};
+
+	static uint64 const HashPrime32 = 0x9E3779B1ull;
+	static uint64 const HashPrime64[3] = {0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull};
+
+	inline uint64 hash_avalanche(uint64 Hash)
+	{
+		Hash ^= Hash >> 33;
+		Hash *= HashPrime64[1];
+		Hash ^= Hash >> 29;
+		Hash *= HashPrime64[2];
+		Hash ^= Hash >> 32;
+		return Hash;
+	}
+
+	inline void hash_scramble(uint64 Acc[4])
+	{
+		for(int i = 0; i < 4; ++i)
+			Acc[i] = (Acc[i] ^ (Acc[i] >> 47) ^ HashKeys[1][i]) * HashPrime32;
+	}
+
+	inline void hash_stripes(uint64 Acc[4], uint8 const* Data, size_t StripeCount)
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			__m128i Acc01 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Acc));
+			__m128i Acc23 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Acc + 2));
+			__m128i const Key01 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(HashKeys[0]));
+			__m128i const Key23 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(HashKeys[0] + 2));
+
+			for(size_t StripeIndex = 0; StripeIndex < StripeCount; ++StripeIndex, Data += 32)
+			{
+				__m128i const Data01 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Data));
+				__m128i const Data23 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Data + 16));
+				__m128i const DataKey01 = _mm_xor_si128(Data01, Key01);
+				__m128i const DataKey23 = _mm_xor_si128(Data23, Key23);
+
+				Acc01 = _mm_add_epi64(Acc01, _mm_mul_epu32(DataKey01, _mm_srli_epi64(DataKey01, 32)));
+				Acc23 = _mm_add_epi64(Acc23, _mm_mul_epu32(DataKey23, _mm_srli_epi64(DataKey23, 32)));
+				Acc01 = _mm_add_epi64(Acc01, _mm_shuffle_epi32(Data01, _MM_SHUFFLE(1, 0, 3, 2)));
+				Acc23 = _mm_add_epi64(Acc23, _mm_shuffle_epi32(Data23, _MM_SHUFFLE(1, 0, 3, 2)));
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Acc), Acc01);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Acc + 2), Acc23);
+#		else
+			for(size_t StripeIndex = 0; StripeIndex < StripeCount; ++StripeIndex, Data += 32)
+			{
+				uint64 Lanes[4];
+				std::memcpy(Lanes, Data, sizeof(Lanes));
+
+				for(int i = 0; i < 4; ++i)
+				{
+					uint64 const DataKey = Lanes[i] ^ HashKeys[0][i];
+					Acc[i] += (DataKey & 0xFFFFFFFFull) * (DataKey >> 32);
+					Acc[i ^ 1] += Lanes[i];
+				}
+			}
+#		endif
+	}
+
+	// Hash Size bytes of Data. The result is the same with or without SIMD instructions.
+	inline uint64 hash_bytes(void const* Data, size_t Size, uint64 Seed)
+	{
+		size_t const StripesPerBlock = 32;
+
+		uint64 Acc[4] = {HashPrime64[0] + Seed, HashPrime64[1] - Seed, HashPrime64[2] ^ Seed, HashPrime32 + Seed};
+		uint8 const* Bytes = static_cast<uint8 const*>(Data);
+
+		size_t const StripeCount = Size / 32;
+		for(size_t StripeIndex = 0; StripeIndex < StripeCount; StripeIndex += StripesPerBlock)
+		{
+			size_t const Count = std::min(StripesPerBlock, StripeCount - StripeIndex);
+			hash_stripes(Acc, Bytes + StripeIndex * 32, Count);
+			if(Count == StripesPerBlock)
+				hash_scramble(Acc);
+		}
+
+		// The remaining bytes are hashed as a last stripe padded with zeros
+		if(Size % 32)
+		{
+			uint8 Stripe[32] = {0};
+			std::memcpy(Stripe, Bytes + StripeCount * 32, Size % 32);
+			hash_stripes(Acc, Stripe, 1);
+		}
+
+		uint64 Hash = static_cast<uint64>(Size) * HashPrime64[0];
+		for(int i = 0; i < 4; ++i)
+			Hash = (Hash ^ hash_avalanche(Acc[i] ^ HashKeys[2][i])) * HashPrime64[0];
+
+		return hash_avalanche(Hash);
+	}
+
+	// Combine the hash of a value to Hash
+	inline uint64 hash_combine(uint64 Hash, uint64 Value)
+	{
+		return hash_avalanche(Hash ^ (Value + HashPrime64[0] + (Hash << 6) + (Hash >> 2)));
+	}
+}//namespace detail
+}//namespace gli
@@ -81,19 +81,20 @@ namespace detail
 	inline image::image()
 		: Format(static_cast<gli::format>(FORMAT_INVALID))
 		, BaseLevel(0)
-		, Data(nullptr)
+		, Offset(0)
 		, Size(0)
 	{}
 
 	inline image::image
 	(
 		format_type Format,
-		extent_type const& Extent
+		extent_type const& Extent,
+		storage_layout Layout
 	)
-		: Storage(std::make_shared<storage_linear>(Format, Extent, 1, 1, 1))
+		: Storage(std::make_shared<storage_linear>(Format, Extent, 1, 1, 1, nullptr, STORAGE_INIT_ZERO, Layout))
 		, Format(Format)
 		, BaseLevel(0)
-		, Data(Storage->data())
+		, Offset(0)
 		, Size(compute_size(0))
 	{}
 
@@ -108,7 +109,7 @@ namespace detail
 		: Storage(Storage)
 		, Format(Format)
 		, BaseLevel(BaseLevel)
-		, Data(compute_data(BaseLayer, BaseFace, BaseLevel))
+		, Offset(compute_offset(BaseLayer, BaseFace, BaseLevel))
 		, Size(compute_size(BaseLevel))
 	{}
 
@@ -120,7 +121,7 @@ namespace detail
 		: Storage(Image.Storage)
 		, Format(Format)
 		, BaseLevel(Image.BaseLevel)
-		, Data(Image.Data)
+		, Offset(Image.Offset)
 		, Size(Image.Size)
 	{
 		GLI_ASSERT(block_size(Format) == block_size(Image.format()));
@@ -164,18 +165,26 @@ namespace detail
 		return glm::max(DstExtent, storage_linear::extent_type(1));
 	}
 
+	inline storage_layout image::layout() const
+	{
+		if(this->empty())
+			return STORAGE_LAYOUT_LINEAR;
+		return this->Storage->layout();
+	}
+
 	inline void* image::data()
 	{
 		GLI_ASSERT(!this->empty());
 
-		return this->Data;
+		return this->Storage->data() + this->Offset;
 	}
 
 	inline void const* image::data() const
 	{
 		GLI_ASSERT(!this->empty());
-		
-		return this->Data;
+
+		storage_linear const& Storage = *this->Storage;
+		return Storage.data() + this->Offset;
 	}
 
 	template <typename genType>
@@ -213,11 +222,9 @@ namespace detail
 			*(this->data<genType>() + TexelIndex) = Texel;
 	}
 
-	inline image::data_type* image::compute_data(size_type BaseLayer, size_type BaseFace, size_type BaseLevel)
+	inline image::size_type image::compute_offset(size_type BaseLayer, size_type BaseFace, size_type BaseLevel) const
 	{
-		size_type const BaseOffset = this->Storage->base_offset(BaseLayer, BaseFace, BaseLevel);
-
-		return this->Storage->data() + BaseOffset;
+		return this->Storage->base_offset(BaseLayer, BaseFace, BaseLevel);
 	}
 
 	inline image::size_type image::compute_size(size_type Level) const
@@ -228,14 +235,14 @@ namespace detail
 	}
 
 	template <typename genType>
-	genType image::load(extent_type const& TexelCoord)
+	genType image::load(extent_type const& TexelCoord) const
 	{
 		GLI_ASSERT(!this->empty());
 		GLI_ASSERT(!is_compressed(this->format()));
 		GLI_ASSERT(this->Storage->block_size() == sizeof(genType));
 		GLI_ASSERT(glm::all(glm::lessThan(TexelCoord, this->extent())));
 
-		return *(this->data<genType>() + detail::texel_linear_addressing(this->extent(), TexelCoord));
+		return *(this->data<genType>() + this->Storage->image_offset(TexelCoord, this->extent()));
 	}
 
 	template <typename genType>
@@ -246,6 +253,6 @@ namespace detail
 		GLI_ASSERT(this->Storage->block_size() == sizeof(genType));
 		GLI_ASSERT(glm::all(glm::lessThan(TexelCoord, this->extent())));
 
-		*(this->data<genType>() + detail::texel_linear_addressing(this->extent(), TexelCoord)) = Data;
+		*(this->data<genType>() + this->Storage->image_offset(TexelCoord, this->extent())) = Data;
 	}
 }//namespace gli
@@ -0,0 +1,59 @@
+namespace gli{
+namespace detail
+{
+	// Allocate a texture laid out by Layout, with the default allocator and swizzles
+	inline texture make_texture(target Target, format Format, texture::extent_type const& Extent, size_t Layers, size_t Faces, size_t Levels, storage_layout Layout)
+	{
+		return texture(Target, Format, Extent, Layers, Faces, Levels, default_allocator(), STORAGE_INIT_ZERO, texture::swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA), Layout);
+	}
+
+	// Copy the images of Src to Dst which layout may be different.
+	// Texels are copied by runs of texels of a row contiguous in both layouts: a row of a tile in a tiled layout.
+	inline void copy_layout(texture const& Src, texture& Dst)
+	{
+		GLI_ASSERT(Src.format() == Dst.format() && Src.size() == Dst.size());
+
+		size_t const BlockSize = block_size(Src.format());
+		int const BlockWidth = block_extent(Src.format()).x;
+		storage_layout const LayoutSrc = Src.layout();
+		storage_layout const LayoutDst = Dst.layout();
+
+		for_each_image_band(split_image_bands(Src, 0, Src.layers() - 1, 0, Src.faces() - 1, 0, Src.levels() - 1), [&](image_band const& Band)
+		{
+			texture::extent_type const Extent(Src.extent(Band.Level));
+			glm::byte const* const ImageSrc = static_cast<glm::byte const*>(Src.data(Band.Layer, Band.Face, Band.Level));
+			glm::byte* const ImageDst = static_cast<glm::byte*>(Dst.data(Band.Layer, Band.Face, Band.Level));
+
+			// Identical layouts and single rows images are copied as they are, the bands covering the images by rows of blocks
+			if(LayoutSrc == LayoutDst || Extent.y == 1)
+			{
+				size_t const RowSize = static_cast<size_t>(glm::ceilMultiple(Extent.x, BlockWidth) / BlockWidth) * BlockSize;
+				size_t const First = static_cast<size_t>(Band.Begin) * RowSize;
+				std::memcpy(ImageDst + First, ImageSrc + First, static_cast<size_t>(Band.End - Band.Begin) * RowSize);
+				return;
+			}
+
+			for(int Row = Band.Begin; Row < Band.End; ++Row)
+			for(int x = 0; x < Extent.x; x += 4)
+			{
+				std::memcpy(
+					ImageDst + layout_texel_offset(LayoutDst, Extent, x, Row) * BlockSize,
+					ImageSrc + layout_texel_offset(LayoutSrc, Extent, x, Row) * BlockSize,
+					static_cast<size_t>(std::min(4, Extent.x - x)) * BlockSize);
+			}
+		});
+	}
+}//namespace detail
+
+	template <typename texture_type>
+	inline texture_type convert_layout(texture_type const& Texture, storage_layout Layout)
+	{
+		GLI_ASSERT(Layout == STORAGE_LAYOUT_LINEAR || !is_compressed(Texture.format()));
+
+		texture Storage(Texture.target(), Texture.format(), Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), default_allocator(), STORAGE_INIT_NONE, Texture.swizzles(), Layout);
+
+		detail::copy_layout(Texture, Storage);
+
+		return texture_type(Storage);
+	}
+}//namespace gli
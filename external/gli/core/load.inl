@@ -5,46 +5,45 @@
 
 namespace gli
 {
-	/// Load a texture (DDS, KTX or KMG) from memory
-	inline texture load(char const * Data, std::size_t Size)
+namespace detail
+{
+	inline texture load(char const * Data, std::size_t Size, std::shared_ptr<char> const& File)
 	{
 		{
-			texture Texture = load_dds(Data, Size);
+			texture Texture = load_dds(Data, Size, File, subresource_range());
 			if(!Texture.empty())
 				return Texture;
 		}
 		{
-			texture Texture = load_kmg(Data, Size);
+			texture Texture = load_kmg(Data, Size, File);
 			if(!Texture.empty())
 				return Texture;
 		}
 		{
-			texture Texture = load_ktx(Data, Size);
+			texture Texture = load_ktx(Data, Size, File, subresource_range());
 			if(!Texture.empty())
 				return Texture;
 		}
 
 		return texture();
 	}
+}//namespace detail
+
+	/// Load a texture (DDS, KTX or KMG) from memory
+	inline texture load(char const * Data, std::size_t Size)
+	{
+		return detail::load(Data, Size, nullptr);
+	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
 	inline texture load(char const * Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
 		if(!File)
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
-
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
-
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
-
-		return load(&Data[0], Data.size());
+		return detail::load(File.get(), Size, File);
 	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
@@ -0,0 +1,236 @@
+namespace gli{
+namespace detail
+{
+	enum load_status
+	{
+		LOAD_STATUS_QUEUED,
+		LOAD_STATUS_RUNNING,
+		LOAD_STATUS_DONE,
+		LOAD_STATUS_CANCELLED
+	};
+
+	struct load_state
+	{
+		load_state()
+			: Future(Promise.get_future().share())
+			, Status(LOAD_STATUS_QUEUED)
+		{}
+
+		std::promise<texture> Promise;
+		std::shared_future<texture> Future;
+		std::atomic<int> Status;
+	};
+
+	// std::priority_queue pops the greatest job first: the highest priority, then the first queued
+	inline bool load_job_order::operator()(load_job const& A, load_job const& B) const
+	{
+		if(A.Priority != B.Priority)
+			return A.Priority < B.Priority;
+		return A.Sequence > B.Sequence;
+	}
+
+	// Make the future of a load that didn't start ready with an empty texture
+	inline bool cancel_load(load_state& State)
+	{
+		int Expected = LOAD_STATUS_QUEUED;
+		if(!State.Status.compare_exchange_strong(Expected, LOAD_STATUS_CANCELLED))
+			return false;
+
+		State.Promise.set_value(texture());
+		return true;
+	}
+
+	inline texture run_load_job(load_job const& Job)
+	{
+		texture Texture;
+		if(Job.Data)
+		{
+			// The texture may reference the data, which is kept alive by the texture
+			std::shared_ptr<std::vector<char> > const Data(Job.Data);
+			std::shared_ptr<char> const Memory(Data, Data->data());
+			Texture = detail::load(Memory.get(), Data->size(), Memory);
+		}
+		else
+			Texture = gli::load(Job.Path);
+
+		if(!Texture.empty() && Job.Process)
+			Texture = Job.Process(Texture);
+
+		return Texture;
+	}
+}//namespace detail
+
+	inline load_handle::load_handle()
+	{}
+
+	inline load_handle::load_handle(std::shared_ptr<detail::load_state> const& State)
+		: State(State)
+	{}
+
+	inline bool load_handle::valid() const
+	{
+		return this->State != nullptr;
+	}
+
+	inline texture load_handle::get() const
+	{
+		GLI_ASSERT(this->valid());
+		return this->State->Future.get();
+	}
+
+	inline void load_handle::wait() const
+	{
+		GLI_ASSERT(this->valid());
+		this->State->Future.wait();
+	}
+
+	inline bool load_handle::ready() const
+	{
+		GLI_ASSERT(this->valid());
+		return this->State->Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	inline bool load_handle::cancel()
+	{
+		GLI_ASSERT(this->valid());
+		return detail::cancel_load(*this->State);
+	}
+
+	inline std::shared_future<texture> const& load_handle::future() const
+	{
+		GLI_ASSERT(this->valid());
+		return this->State->Future;
+	}
+
+	inline loader::loader(size_t ThreadCount)
+		: Sequence(0)
+		, Running(0)
+		, Stop(false)
+	{
+		if(ThreadCount == 0)
+			ThreadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		for(size_t ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+			this->Threads.push_back(std::thread(&loader::run_worker, this));
+	}
+
+	inline loader::~loader()
+	{
+		this->cancel();
+
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Stop = true;
+		}
+		this->WorkCondition.notify_all();
+
+		for(size_t ThreadIndex = 0; ThreadIndex < this->Threads.size(); ++ThreadIndex)
+			this->Threads[ThreadIndex].join();
+	}
+
+	inline load_handle loader::load(std::string const& Path, int Priority, process_type const& Process, callback_type const& Callback)
+	{
+		detail::load_job Job;
+		Job.Path = Path;
+		Job.Process = Process;
+		Job.Callback = Callback;
+		Job.Priority = Priority;
+		return this->push(Job);
+	}
+
+	inline load_handle loader::load(std::vector<char> Data, int Priority, process_type const& Process, callback_type const& Callback)
+	{
+		detail::load_job Job;
+		Job.Data = std::make_shared<std::vector<char> >(std::move(Data));
+		Job.Process = Process;
+		Job.Callback = Callback;
+		Job.Priority = Priority;
+		return this->push(Job);
+	}
+
+	inline load_handle loader::push(detail::load_job& Job)
+	{
+		Job.State = std::make_shared<detail::load_state>();
+		load_handle Handle(Job.State);
+
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Job.Sequence = this->Sequence++;
+			Job.MemoryTag = detail::current_memory_tag();
+			this->Jobs.push(std::move(Job));
+		}
+		this->WorkCondition.notify_one();
+
+		return Handle;
+	}
+
+	inline void loader::wait()
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->DoneCondition.wait(Lock, [this]{return this->Jobs.empty() && this->Running == 0;});
+	}
+
+	inline void loader::cancel()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		while(!this->Jobs.empty())
+		{
+			detail::cancel_load(*this->Jobs.top().State);
+			this->Jobs.pop();
+		}
+		this->DoneCondition.notify_all();
+	}
+
+	inline size_t loader::thread_count() const
+	{
+		return this->Threads.size();
+	}
+
+	inline void loader::run_worker()
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		for(;;)
+		{
+			this->WorkCondition.wait(Lock, [this]{return this->Stop || !this->Jobs.empty();});
+			if(this->Jobs.empty())
+				return;
+
+			detail::load_job const Job(this->Jobs.top());
+			this->Jobs.pop();
+
+			// Jobs cancelled through their handle are skipped
+			int Expected = detail::LOAD_STATUS_QUEUED;
+			if(!Job.State->Status.compare_exchange_strong(Expected, detail::LOAD_STATUS_RUNNING))
+			{
+				if(this->Jobs.empty() && this->Running == 0)
+					this->DoneCondition.notify_all();
+				continue;
+			}
+
+			++this->Running;
+			Lock.unlock();
+
+			// Textures loaded and processed are tagged like the storages of the thread queuing the job
+			detail::current_memory_tag() = Job.MemoryTag;
+
+			try
+			{
+				texture const Texture = detail::run_load_job(Job);
+				if(Job.Callback)
+					Job.Callback(Texture);
+				Job.State->Status = detail::LOAD_STATUS_DONE;
+				Job.State->Promise.set_value(Texture);
+			}
+			catch(...)
+			{
+				Job.State->Status = detail::LOAD_STATUS_DONE;
+				Job.State->Promise.set_exception(std::current_exception());
+			}
+
+			Lock.lock();
+			--this->Running;
+			if(this->Jobs.empty() && this->Running == 0)
+				this->DoneCondition.notify_all();
+		}
+	}
+}//namespace gli
@@ -158,9 +158,8 @@ namespace detail
 			return dx::D3DFMT_AT2N;
 		}
 	}
-}//namespace detail
 
-	inline texture load_dds(char const * Data, std::size_t Size)
+	inline texture load_dds(char const * Data, std::size_t Size, std::shared_ptr<char> const& File, subresource_range const& Range)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_DDS)));
 
@@ -285,40 +284,73 @@ namespace detail
 		if(Header.CubemapFlags & detail::DDSCAPS2_VOLUME)
 			DepthCount = Header.Depth;
 
-		texture Texture(
-			get_target(Header, Header10), Format,
-			texture::extent_type(Header.Width, Header.Height, DepthCount),
-			std::max<texture::size_type>(Header10.ArraySize, 1), FaceCount, MipMapCount);
+		target const Target = get_target(Header, Header10);
+		texture::extent_type const Extent(Header.Width, Header.Height, DepthCount);
+		texture::size_type const LayerCount = std::max<texture::size_type>(Header10.ArraySize, 1);
 
-		std::size_t const SourceSize = Offset + Texture.size();
-		GLI_ASSERT(SourceSize == Size);
+		// DDS stores the images in the same order and packing as texture storage, use them in place
+		std::shared_ptr<texture::data_type> const Memory = share_file_memory(File, Data + Offset, Format);
+		texture const Source(Target, Format, Extent, LayerCount, FaceCount, MipMapCount, Memory ? Memory : borrow_memory(Data + Offset));
 
-		std::memcpy(Texture.data(), Data + Offset, Texture.size());
+		// Truncated files are rejected, trailing data ignored
+		std::size_t const SourceSize = Offset + Source.size();
+		if(SourceSize > Size)
+			return texture();
 
-		return Texture;
+		return copy_subresources(Source, static_cast<bool>(Memory), Range);
+	}
+}//namespace detail
+
+	inline texture load_dds(char const * Data, std::size_t Size)
+	{
+		return detail::load_dds(Data, Size, nullptr, detail::subresource_range());
 	}
 
 	inline texture load_dds(char const * Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
 		if(!File)
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
+		return detail::load_dds(File.get(), Size, File, detail::subresource_range());
+	}
 
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
+	inline texture load_dds(std::string const & Filename)
+	{
+		return load_dds(Filename.c_str());
+	}
+
+	inline texture load_dds(
+		char const * Data, std::size_t Size,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
+	{
+		return detail::load_dds(Data, Size, nullptr, detail::subresource_range(BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel));
+	}
 
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
+	inline texture load_dds(
+		char const * Filename,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
+	{
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
+		if(!File)
+			return texture();
 
-		return load_dds(&Data[0], Data.size());
+		// Only the pages of the requested images are read from the mapping
+		return detail::load_dds(File.get(), Size, nullptr, detail::subresource_range(BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel));
 	}
 
-	inline texture load_dds(std::string const & Filename)
+	inline texture load_dds(
+		std::string const & Filename,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
 	{
-		return load_dds(Filename.c_str());
+		return load_dds(Filename.c_str(), BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel);
 	}
 }//namespace gli
@@ -27,20 +27,37 @@ namespace detail
 		std::uint32_t MaxLevel;
 	};
 
-	inline texture load_kmg100(char const * Data, std::size_t Size)
+	inline texture load_kmg100(char const * Data, std::size_t Size, std::shared_ptr<char> const& File)
 	{
 		detail::kmgHeader10 const & Header(*reinterpret_cast<detail::kmgHeader10 const *>(Data));
 
 		size_t Offset = sizeof(detail::kmgHeader10);
 
-		texture Texture(
-			static_cast<target>(Header.Target),
-			static_cast<format>(Header.Format),
-			texture::extent_type(Header.PixelWidth, Header.PixelHeight, Header.PixelDepth),
-			Header.Layers,
-			Header.Faces,
-			Header.Levels,
-			texture::swizzles_type(Header.SwizzleRed, Header.SwizzleGreen, Header.SwizzleBlue, Header.SwizzleAlpha));
+		target const Target = static_cast<target>(Header.Target);
+		format const Format = static_cast<format>(Header.Format);
+		texture::extent_type const Extent(Header.PixelWidth, Header.PixelHeight, Header.PixelDepth);
+		texture::swizzles_type const Swizzles(Header.SwizzleRed, Header.SwizzleGreen, Header.SwizzleBlue, Header.SwizzleAlpha);
+
+		// KMG stores the faces of a level together; with a single face this is the texture storage layout, use it in place.
+		if(Header.Faces == 1)
+		{
+			std::shared_ptr<texture::data_type> const Memory = share_file_memory(File, Data + Offset, Format);
+			if(Memory)
+			{
+				texture Texture(Target, Format, Extent, Header.Layers, Header.Faces, Header.Levels, Memory, Swizzles);
+				if(Offset + Texture.size() <= Size)
+				{
+					return texture(
+						Texture, Texture.target(), Texture.format(),
+						Texture.base_layer(), Texture.max_layer(),
+						Texture.base_face(), Texture.max_face(),
+						Header.BaseLevel, Header.MaxLevel,
+						Texture.swizzles());
+				}
+			}
+		}
+
+		texture Texture(Target, Format, Extent, Header.Layers, Header.Faces, Header.Levels, Swizzles);
 
 		for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
 		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
@@ -62,38 +79,34 @@ namespace detail
 			Header.BaseLevel, Header.MaxLevel, 
 			Texture.swizzles());
 	}
-}//namespace detail
 
-	inline texture load_kmg(char const * Data, std::size_t Size)
+	inline texture load_kmg(char const * Data, std::size_t Size, std::shared_ptr<char> const& File)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::kmgHeader10)));
 
 		// KMG100
 		{
 			if(memcmp(Data, detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100)) == 0)
-				return detail::load_kmg100(Data + sizeof(detail::FOURCC_KMG100), Size - sizeof(detail::FOURCC_KMG100));
+				return detail::load_kmg100(Data + sizeof(detail::FOURCC_KMG100), Size - sizeof(detail::FOURCC_KMG100), File);
 		}
 
 		return texture();
 	}
+}//namespace detail
+
+	inline texture load_kmg(char const * Data, std::size_t Size)
+	{
+		return detail::load_kmg(Data, Size, nullptr);
+	}
 
 	inline texture load_kmg(char const * Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
 		if(!File)
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
-
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
-
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
-
-		return load_kmg(&Data[0], Data.size());
+		return detail::load_kmg(File.get(), Size, File);
 	}
 
 	inline texture load_kmg(std::string const & Filename)
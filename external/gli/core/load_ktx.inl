@@ -50,7 +50,7 @@ namespace detail
 			return TARGET_2D;
 	}
 
-	inline texture load_ktx10(char const* Data, std::size_t Size)
+	inline texture load_ktx10(char const* Data, std::size_t Size, std::shared_ptr<char> const& File, subresource_range Range)
 	{
 		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data));
 
@@ -68,70 +68,135 @@ namespace detail
 		
 		texture::size_type const BlockSize = block_size(Format);
 
+		target const Target = detail::get_target(Header);
+		texture::extent_type const Extent(
+			Header.PixelWidth,
+			std::max<texture::size_type>(Header.PixelHeight, 1),
+			std::max<texture::size_type>(Header.PixelDepth, 1));
+		texture::size_type const Layers = std::max<texture::size_type>(Header.NumberOfArrayElements, 1);
+		texture::size_type const Faces = std::max<texture::size_type>(Header.NumberOfFaces, 1);
+		texture::size_type const Levels = std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1);
+
+		if(!Range.clamp(Layers, Faces, Levels))
+			return texture();
+
+		// KTX stores the images level by level, each prefixed by its size and padded to 4 bytes.
+		// With a single level and no padding this is the texture storage layout, use it in place.
+		if(Levels == 1 && Range.whole(Layers, Faces, Levels))
+		{
+			std::shared_ptr<texture::data_type> const Memory = share_file_memory(File, Data + Offset + sizeof(std::uint32_t), Format);
+			if(Memory)
+			{
+				texture Texture(Target, Format, Extent, Layers, Faces, Levels, Memory);
+				texture::size_type const FaceSize = Texture.size(0);
+				if((Layers * Faces == 1 || FaceSize % 4 == 0) && Offset + sizeof(std::uint32_t) + Texture.size() <= Size)
+					return Texture;
+			}
+		}
+
 		texture Texture(
-			detail::get_target(Header),
-			Format,
-			texture::extent_type(
-				Header.PixelWidth,
-				std::max<texture::size_type>(Header.PixelHeight, 1),
-				std::max<texture::size_type>(Header.PixelDepth, 1)),
-			std::max<texture::size_type>(Header.NumberOfArrayElements, 1),
-			std::max<texture::size_type>(Header.NumberOfFaces, 1),
-			std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1));
-
-		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
+			Target, Format,
+			glm::max(Extent >> texture::extent_type(static_cast<texture::extent_type::value_type>(Range.BaseLevel)), texture::extent_type(1)),
+			Range.MaxLayer - Range.BaseLayer + 1,
+			Range.MaxFace - Range.BaseFace + 1,
+			Range.MaxLevel - Range.BaseLevel + 1,
+			default_allocator(), STORAGE_INIT_NONE);
+
+		texture::extent_type const BlockExtent = block_extent(Format);
+
+		// Walk the levels up to the last one requested, copying the images in range
+		for(texture::size_type Level = 0; Level <= Range.MaxLevel; ++Level)
 		{
 			Offset += sizeof(std::uint32_t);
 
-			for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
-			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
-			{
-				texture::size_type const FaceSize = Texture.size(Level);
+			texture::extent_type const LevelExtent = glm::max(Extent >> texture::extent_type(static_cast<texture::extent_type::value_type>(Level)), texture::extent_type(1));
+			texture::size_type const FaceSize = BlockSize * glm::compMul(glm::ceilMultiple(LevelExtent, BlockExtent) / BlockExtent);
+			texture::size_type const FaceStride = std::max(BlockSize, glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4)));
 
-				std::memcpy(Texture.data(Layer, Face, Level), Data + Offset, FaceSize);
+			if(Offset + FaceStride * Layers * Faces > Size)
+				return texture();
 
-				Offset += std::max(BlockSize, glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4)));
+			if(Level >= Range.BaseLevel)
+			{
+				for(texture::size_type Layer = Range.BaseLayer; Layer <= Range.MaxLayer; ++Layer)
+				for(texture::size_type Face = Range.BaseFace; Face <= Range.MaxFace; ++Face)
+				{
+					std::memcpy(
+						Texture.data(Layer - Range.BaseLayer, Face - Range.BaseFace, Level - Range.BaseLevel),
+						Data + Offset + (Layer * Faces + Face) * FaceStride, FaceSize);
+				}
 			}
+
+			Offset += FaceStride * Layers * Faces;
 		}
 
 		return Texture;
 	}
-}//namespace detail
 
-	inline texture load_ktx(char const* Data, std::size_t Size)
+	inline texture load_ktx(char const* Data, std::size_t Size, std::shared_ptr<char> const& File, subresource_range const& Range)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::ktx_header10)));
 
 		// KTX10
 		{
 			if(memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
-				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10));
+				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10), File, Range);
 		}
 
 		return texture();
 	}
+}//namespace detail
+
+	inline texture load_ktx(char const* Data, std::size_t Size)
+	{
+		return detail::load_ktx(Data, Size, nullptr, detail::subresource_range());
+	}
 
 	inline texture load_ktx(char const* Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
 		if(!File)
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
+		return detail::load_ktx(File.get(), Size, File, detail::subresource_range());
+	}
+
+	inline texture load_ktx(std::string const& Filename)
+	{
+		return load_ktx(Filename.c_str());
+	}
 
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
+	inline texture load_ktx(
+		char const* Data, std::size_t Size,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
+	{
+		return detail::load_ktx(Data, Size, nullptr, detail::subresource_range(BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel));
+	}
 
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
+	inline texture load_ktx(
+		char const* Filename,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
+	{
+		std::size_t Size = 0;
+		std::shared_ptr<char> const File = detail::map_file(Filename, Size);
+		if(!File)
+			return texture();
 
-		return load_ktx(&Data[0], Data.size());
+		// Only the pages of the requested images are read from the mapping
+		return detail::load_ktx(File.get(), Size, nullptr, detail::subresource_range(BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel));
 	}
 
-	inline texture load_ktx(std::string const& Filename)
+	inline texture load_ktx(
+		std::string const& Filename,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel)
 	{
-		return load_ktx(Filename.c_str());
+		return load_ktx(Filename.c_str(), BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel);
 	}
 }//namespace gli
@@ -0,0 +1,203 @@
+#include <algorithm>
+
+namespace gli{
+namespace detail
+{
+	inline void add_allocation(memory_counters& Counters, size_t Size)
+	{
+		Counters.LiveBytes += Size;
+		Counters.PeakBytes = std::max(Counters.PeakBytes, Counters.LiveBytes);
+		++Counters.Allocations;
+	}
+
+	inline void add_deallocation(memory_counters& Counters, size_t Size)
+	{
+		GLI_ASSERT(Counters.LiveBytes >= Size);
+
+		Counters.LiveBytes -= Size;
+		++Counters.Deallocations;
+	}
+
+	inline void reset_peak(memory_counters& Counters)
+	{
+		Counters.PeakBytes = Counters.LiveBytes;
+	}
+
+	// The last bucket of the formats and of the targets holds the invalid ones
+	inline size_t format_bucket(format Format)
+	{
+		return is_valid(Format) ? static_cast<size_t>(Format - FORMAT_FIRST) : static_cast<size_t>(FORMAT_COUNT);
+	}
+
+	inline size_t target_bucket(target Target)
+	{
+		return Target >= TARGET_FIRST && Target <= TARGET_LAST ? static_cast<size_t>(Target - TARGET_FIRST) : static_cast<size_t>(TARGET_COUNT);
+	}
+
+	inline memory_accounting::memory_accounting()
+		: Total()
+		, Formats(FORMAT_COUNT + 1, memory_counters())
+		, Targets(TARGET_COUNT + 1, memory_counters())
+		, Tags(1, std::make_pair(std::string(), memory_counters()))
+		, DumpPeriod(0)
+	{}
+
+	inline void memory_accounting::allocated(memory_key const& Key, size_t Size)
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+
+		add_allocation(this->Total, Size);
+		add_allocation(this->Formats[format_bucket(Key.Format)], Size);
+		add_allocation(this->Targets[target_bucket(Key.Target)], Size);
+		add_allocation(this->Tags[Key.Tag].second, Size);
+
+		this->dump_if_due(Lock);
+	}
+
+	inline void memory_accounting::deallocated(memory_key const& Key, size_t Size)
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+
+		add_deallocation(this->Total, Size);
+		add_deallocation(this->Formats[format_bucket(Key.Format)], Size);
+		add_deallocation(this->Targets[target_bucket(Key.Target)], Size);
+		add_deallocation(this->Tags[Key.Tag].second, Size);
+
+		this->dump_if_due(Lock);
+	}
+
+	inline size_t memory_accounting::intern(char const* Tag)
+	{
+		std::string const Name(Tag ? Tag : "");
+
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		// Few tags are expected, they are only looked up when entering a memory_tag scope
+		for(size_t TagIndex = 0, TagCount = this->Tags.size(); TagIndex < TagCount; ++TagIndex)
+			if(this->Tags[TagIndex].first == Name)
+				return TagIndex;
+
+		this->Tags.push_back(std::make_pair(Name, memory_counters()));
+		return this->Tags.size() - 1;
+	}
+
+	inline memory_usage memory_accounting::usage()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		return this->usage_locked();
+	}
+
+	inline memory_usage memory_accounting::usage_locked() const
+	{
+		memory_usage Usage;
+		Usage.Total = this->Total;
+
+		for(size_t FormatIndex = 0; FormatIndex < this->Formats.size(); ++FormatIndex)
+			if(this->Formats[FormatIndex].Allocations > 0)
+				Usage.Formats[FormatIndex < FORMAT_COUNT ? static_cast<format>(FORMAT_FIRST + FormatIndex) : static_cast<format>(FORMAT_INVALID)] = this->Formats[FormatIndex];
+
+		for(size_t TargetIndex = 0; TargetIndex < this->Targets.size(); ++TargetIndex)
+			if(this->Targets[TargetIndex].Allocations > 0)
+				Usage.Targets[TargetIndex < TARGET_COUNT ? static_cast<target>(TARGET_FIRST + TargetIndex) : static_cast<target>(TARGET_INVALID)] = this->Targets[TargetIndex];
+
+		for(size_t TagIndex = 0; TagIndex < this->Tags.size(); ++TagIndex)
+			if(this->Tags[TagIndex].second.Allocations > 0)
+				Usage.Tags[this->Tags[TagIndex].first] = this->Tags[TagIndex].second;
+
+		return Usage;
+	}
+
+	inline void memory_accounting::reset_peaks()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		reset_peak(this->Total);
+		std::for_each(this->Formats.begin(), this->Formats.end(), reset_peak);
+		std::for_each(this->Targets.begin(), this->Targets.end(), reset_peak);
+		for(size_t TagIndex = 0; TagIndex < this->Tags.size(); ++TagIndex)
+			reset_peak(this->Tags[TagIndex].second);
+	}
+
+	inline void memory_accounting::set_dump(memory_dump_func const& Dump, std::chrono::milliseconds Period)
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		this->Dump = Dump;
+		this->DumpPeriod = Period;
+		this->DumpTime = std::chrono::steady_clock::now();
+	}
+
+	inline void memory_accounting::dump_if_due(std::unique_lock<std::mutex>& Lock)
+	{
+		if(!this->Dump)
+			return;
+
+		std::chrono::steady_clock::time_point const Now = std::chrono::steady_clock::now();
+		if(Now - this->DumpTime < this->DumpPeriod)
+			return;
+		this->DumpTime = Now;
+
+		// The dump function is called without holding the lock so that it may allocate textures itself
+		memory_dump_func const Dump = this->Dump;
+		memory_usage const Usage = this->usage_locked();
+		Lock.unlock();
+
+		// Deallocations are accounted for in the deleter of the memory, which must not throw
+		try
+		{
+			Dump(Usage);
+		}
+		catch(...)
+		{}
+	}
+
+	inline memory_accounting& memory_accounting_instance()
+	{
+		// Never destroyed, storages may outlive the static objects
+		static memory_accounting* const Accounting = new memory_accounting;
+		return *Accounting;
+	}
+
+	inline size_t& current_memory_tag()
+	{
+		static thread_local size_t Tag = 0;
+		return Tag;
+	}
+
+	inline memory_key make_memory_key(format Format, target Target)
+	{
+		memory_key Key;
+		Key.Format = Format;
+		Key.Target = Target;
+		Key.Tag = current_memory_tag();
+		return Key;
+	}
+}//namespace detail
+
+	inline memory_usage current_memory_usage()
+	{
+		return detail::memory_accounting_instance().usage();
+	}
+
+	inline void reset_memory_peaks()
+	{
+		detail::memory_accounting_instance().reset_peaks();
+	}
+
+	inline memory_tag::memory_tag(char const* Tag)
+		: PreviousTag(detail::current_memory_tag())
+	{
+		detail::current_memory_tag() = detail::memory_accounting_instance().intern(Tag);
+	}
+
+	inline memory_tag::~memory_tag()
+	{
+		detail::current_memory_tag() = this->PreviousTag;
+	}
+
+	inline void set_memory_dump(memory_dump_func const& Dump, std::chrono::milliseconds Period)
+	{
+		detail::memory_accounting_instance().set_dump(Dump, Period);
+	}
+}//namespace gli
@@ -0,0 +1,266 @@
+/// @brief Box filter mipmap generation averaging blocks of texels directly in memory
+/// @file gli/core/mipmaps_box.hpp
+
+#pragma once
+
+#include "../format.hpp"
+#include "../execution.hpp"
+#include "convert_func.hpp"
+#include <algorithm>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	// Texels of the previous level averaged into a texel of a box filtered level, along one axis.
+	// Levels of odd sizes are averaged by 2 texels but the last one averaged by 3.
+	struct box_footprint
+	{
+		int First;
+		int Count;
+	};
+
+	inline box_footprint compute_box_footprint(int Index, int Size, int SizePrev)
+	{
+		GLI_ASSERT(Size == std::max(SizePrev >> 1, 1));
+
+		box_footprint Footprint = {std::min(Index * 2, SizePrev - 1), 1};
+		if(SizePrev > 1)
+			Footprint.Count = Index == Size - 1 && (SizePrev & 1) ? 3 : 2;
+		return Footprint;
+	}
+
+	// Compute a row of a box filtered level. Src is the first row of the footprint of the row in the previous level.
+	typedef void (*box_row_func)(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows);
+
+	// 8 bits UNORM components, rounded to nearest
+	template <length_t L>
+	inline void box_row_norm8(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows, int Begin)
+	{
+		for(int i = Begin; i < Width; ++i)
+		{
+			box_footprint const Cols = compute_box_footprint(i, Width, WidthPrev);
+			uint32 const Count = static_cast<uint32>(Rows.Count * Cols.Count);
+
+			for(length_t c = 0; c < L; ++c)
+			{
+				uint32 Sum = 0;
+				for(int r = 0; r < Rows.Count; ++r)
+				for(int k = 0; k < Cols.Count; ++k)
+					Sum += Src[r * SrcPitch + (Cols.First + k) * L + c];
+
+				Dst[i * L + c] = static_cast<glm::byte>((Sum + Count / 2) / Count);
+			}
+		}
+	}
+
+	template <length_t L>
+	inline void box_row_norm8(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows)
+	{
+		box_row_norm8<L>(Dst, Src, SrcPitch, Width, WidthPrev, Rows, 0);
+	}
+
+	// 32 bits float components. Columns sums of the footprint are added, the same order as the SIMD path.
+	template <length_t L>
+	inline void box_row_float(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows, int Begin)
+	{
+		for(int i = Begin; i < Width; ++i)
+		{
+			box_footprint const Cols = compute_box_footprint(i, Width, WidthPrev);
+			float const Count = static_cast<float>(Rows.Count * Cols.Count);
+
+			for(length_t c = 0; c < L; ++c)
+			{
+				float Sum = 0.0f;
+				for(int k = 0; k < Cols.Count; ++k)
+				{
+					float ColSum = 0.0f;
+					for(int r = 0; r < Rows.Count; ++r)
+					{
+						float const Texel = reinterpret_cast<float const*>(Src + r * SrcPitch)[(Cols.First + k) * L + c];
+						ColSum = r == 0 ? Texel : ColSum + Texel;
+					}
+					Sum = k == 0 ? ColSum : Sum + ColSum;
+				}
+
+				reinterpret_cast<float*>(Dst)[i * L + c] = Sum / Count;
+			}
+		}
+	}
+
+	template <length_t L>
+	inline void box_row_float(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows)
+	{
+		box_row_float<L>(Dst, Src, SrcPitch, Width, WidthPrev, Rows, 0);
+	}
+
+	// Number of texels of a row averaged by exactly 2x2 texels
+	inline int box_count_2x2(int Width, int WidthPrev, box_footprint Rows)
+	{
+		if(Rows.Count != 2 || WidthPrev < 2)
+			return 0;
+		return WidthPrev & 1 ? Width - 1 : Width;
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template <>
+	inline void box_row_norm8<4>(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows)
+	{
+		int const Count2x2 = box_count_2x2(Width, WidthPrev, Rows);
+		__m128i const Zero = _mm_setzero_si128();
+		__m128i const Round = _mm_set1_epi16(2);
+
+		int i = 0;
+		for(; i + 4 <= Count2x2; i += 4)
+		{
+			glm::byte const* Row0 = Src + i * 8;
+			glm::byte const* Row1 = Row0 + SrcPitch;
+
+			// Each 16 bytes hold 4 texels of a row, 2 texels of the level
+			__m128i const A0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row0));
+			__m128i const A1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row1));
+			__m128i const B0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row0 + 16));
+			__m128i const B1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row1 + 16));
+
+			__m128i const ALo = _mm_add_epi16(_mm_unpacklo_epi8(A0, Zero), _mm_unpacklo_epi8(A1, Zero));
+			__m128i const AHi = _mm_add_epi16(_mm_unpackhi_epi8(A0, Zero), _mm_unpackhi_epi8(A1, Zero));
+			__m128i const BLo = _mm_add_epi16(_mm_unpacklo_epi8(B0, Zero), _mm_unpacklo_epi8(B1, Zero));
+			__m128i const BHi = _mm_add_epi16(_mm_unpackhi_epi8(B0, Zero), _mm_unpackhi_epi8(B1, Zero));
+
+			__m128i const A = _mm_add_epi16(_mm_unpacklo_epi64(ALo, AHi), _mm_unpackhi_epi64(ALo, AHi));
+			__m128i const B = _mm_add_epi16(_mm_unpacklo_epi64(BLo, BHi), _mm_unpackhi_epi64(BLo, BHi));
+
+			__m128i const Texels = _mm_packus_epi16(
+				_mm_srli_epi16(_mm_add_epi16(A, Round), 2),
+				_mm_srli_epi16(_mm_add_epi16(B, Round), 2));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + i * 4), Texels);
+		}
+
+		box_row_norm8<4>(Dst, Src, SrcPitch, Width, WidthPrev, Rows, i);
+	}
+
+	template <>
+	inline void box_row_float<4>(glm::byte* Dst, glm::byte const* Src, size_t SrcPitch, int Width, int WidthPrev, box_footprint Rows)
+	{
+		int const Count2x2 = box_count_2x2(Width, WidthPrev, Rows);
+		__m128 const Quarter = _mm_set1_ps(0.25f);
+
+		int i = 0;
+		for(; i < Count2x2; ++i)
+		{
+			float const* Row0 = reinterpret_cast<float const*>(Src) + i * 8;
+			float const* Row1 = reinterpret_cast<float const*>(Src + SrcPitch) + i * 8;
+
+			__m128 const Col0 = _mm_add_ps(_mm_loadu_ps(Row0), _mm_loadu_ps(Row1));
+			__m128 const Col1 = _mm_add_ps(_mm_loadu_ps(Row0 + 4), _mm_loadu_ps(Row1 + 4));
+			_mm_storeu_ps(reinterpret_cast<float*>(Dst) + i * 4, _mm_mul_ps(_mm_add_ps(Col0, Col1), Quarter));
+		}
+
+		box_row_float<4>(Dst, Src, SrcPitch, Width, WidthPrev, Rows, i);
+	}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	inline box_row_func find_box_row_func(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_R8_UNORM_PACK8:
+		case FORMAT_L8_UNORM_PACK8:
+		case FORMAT_A8_UNORM_PACK8:
+			return box_row_norm8<1>;
+		case FORMAT_RG8_UNORM_PACK8:
+		case FORMAT_LA8_UNORM_PACK8:
+			return box_row_norm8<2>;
+		case FORMAT_RGB8_UNORM_PACK8:
+		case FORMAT_BGR8_UNORM_PACK8:
+			return box_row_norm8<3>;
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_BGRA8_UNORM_PACK8:
+			return box_row_norm8<4>;
+		case FORMAT_R32_SFLOAT_PACK32:
+			return box_row_float<1>;
+		case FORMAT_RG32_SFLOAT_PACK32:
+			return box_row_float<2>;
+		case FORMAT_RGB32_SFLOAT_PACK32:
+			return box_row_float<3>;
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			return box_row_float<4>;
+		default:
+			return nullptr;
+		}
+	}
+
+	// Box filter the levels of a 2D, 2D array, cube or cube array texture, one level after another.
+	// Formats without a row function are averaged through the texel conversion functions.
+	template <typename texture_type>
+	inline void generate_mipmaps_box
+	(
+		texture_type& Texture,
+		typename texture_type::size_type BaseLayer, typename texture_type::size_type MaxLayer,
+		typename texture_type::size_type BaseFace, typename texture_type::size_type MaxFace,
+		typename texture_type::size_type BaseLevel, typename texture_type::size_type MaxLevel
+	)
+	{
+		typedef typename texture_type::size_type size_type;
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename detail::convert<texture_type, float, defaultp>::func convert_type;
+
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(!is_compressed(Texture.format()));
+
+		// Row functions read the rows of linear textures
+		box_row_func const RowFunc = Texture.layout() == STORAGE_LAYOUT_LINEAR ? find_box_row_func(Texture.format()) : nullptr;
+		convert_type const Convert = detail::convert<texture_type, float, defaultp>::call(Texture.format());
+		size_t const BlockSize = block_size(Texture.format());
+
+		// Memory shared for copy on write is copied once here rather than by the first band writing it while other bands read it
+		Texture.data();
+
+		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+		{
+			extent_type const Extent(Texture.extent(Level + 1));
+			extent_type const ExtentPrev(Texture.extent(Level));
+			size_t const SrcPitch = BlockSize * static_cast<size_t>(ExtentPrev.x);
+
+			for_each_image_band(split_image_bands(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level + 1, Level + 1), [&](image_band const& Band)
+			{
+				glm::byte* DstData = static_cast<glm::byte*>(Texture.texture::data(Band.Layer, Band.Face, Level + 1));
+				glm::byte const* SrcData = static_cast<glm::byte const*>(Texture.texture::data(Band.Layer, Band.Face, Level));
+
+				for(int j = Band.Begin; j < Band.End; ++j)
+				{
+					box_footprint const Rows = compute_box_footprint(j, Extent.y, ExtentPrev.y);
+
+					if(RowFunc)
+					{
+						RowFunc(DstData + j * BlockSize * Extent.x, SrcData + Rows.First * SrcPitch, SrcPitch, Extent.x, ExtentPrev.x, Rows);
+						continue;
+					}
+
+					for(int i = 0; i < Extent.x; ++i)
+					{
+						box_footprint const Cols = compute_box_footprint(i, Extent.x, ExtentPrev.x);
+
+						vec4 Sum(0);
+						for(int k = 0; k < Cols.Count; ++k)
+						{
+							vec4 ColSum(0);
+							for(int r = 0; r < Rows.Count; ++r)
+							{
+								vec4 const Texel = Convert.Fetch(Texture, extent_type(Cols.First + k, Rows.First + r), Band.Layer, Band.Face, Level);
+								ColSum = r == 0 ? Texel : ColSum + Texel;
+							}
+							Sum = k == 0 ? ColSum : Sum + ColSum;
+						}
+
+						Convert.Write(Texture, extent_type(i, j), Band.Layer, Band.Face, Level + 1, Sum / static_cast<float>(Rows.Count * Cols.Count));
+					}
+				}
+			});
+		}
+	}
+}//namespace detail
+}//namespace gli
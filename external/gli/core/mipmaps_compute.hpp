@@ -1,6 +1,7 @@
 #pragma once
 
 #include "filter_compute.hpp"
+#include "../execution.hpp"
 
 namespace gli{
 namespace detail
@@ -24,19 +25,24 @@ namespace detail
 		filter_func const Filter = detail::get_filter<filter_func, detail::DIMENSION_1D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type, sampler_value_type>(FILTER_NEAREST, Min, false);
 		GLI_ASSERT(Filter);
 
-		for(size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
-		for(size_type Face = BaseFace; Face <= MaxFace; ++Face)
+		// Memory shared for copy on write is copied once here rather than by the first band writing it while other bands read it
+		Texture.data();
+
+		// Each level is filtered from the previous one, the bands of a level are independent
 		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
 		{
 			extent_type const& ExtentDst = Texture.extent(Level + 1);
 			normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
 
-			for(component_type i = 0; i < ExtentDst.x; ++i)
+			detail::for_each_image_band(detail::split_image_bands(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level + 1, Level + 1), [&](detail::image_band const& Band)
 			{
-				normalized_type const& SamplePosition(normalized_type(static_cast<typename normalized_type::value_type>(i)) * Scale);
-				texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
-				Write(Texture, extent_type(i), Layer, Face, Level + 1, Texel);
-			}
+				for(component_type i = 0; i < ExtentDst.x; ++i)
+				{
+					normalized_type const& SamplePosition(normalized_type(static_cast<typename normalized_type::value_type>(i)) * Scale);
+					texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Band.Layer, Band.Face, static_cast<sampler_value_type>(Level), texel_type(0));
+					Write(Texture, extent_type(i), Band.Layer, Band.Face, Level + 1, Texel);
+				}
+			});
 		}
 	}
 
@@ -59,20 +65,25 @@ namespace detail
 		filter_func const Filter = detail::get_filter<filter_func, detail::DIMENSION_2D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type, sampler_value_type>(FILTER_NEAREST, Min, false);
 		GLI_ASSERT(Filter);
 
-		for(size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
-		for(size_type Face = BaseFace; Face <= MaxFace; ++Face)
+		// Memory shared for copy on write is copied once here rather than by the first band writing it while other bands read it
+		Texture.data();
+
+		// Each level is filtered from the previous one, the bands of a level are independent
 		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
 		{
 			extent_type const& ExtentDst = Texture.extent(Level + 1);
 			normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
 
-			for(component_type j = 0; j < ExtentDst.y; ++j)
-			for(component_type i = 0; i < ExtentDst.x; ++i)
+			detail::for_each_image_band(detail::split_image_bands(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level + 1, Level + 1), [&](detail::image_band const& Band)
 			{
-				normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
-				texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
-				Write(Texture, extent_type(i, j), Layer, Face, Level + 1, Texel);
-			}
+				for(component_type j = Band.Begin; j < Band.End; ++j)
+				for(component_type i = 0; i < ExtentDst.x; ++i)
+				{
+					normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
+					texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Band.Layer, Band.Face, static_cast<sampler_value_type>(Level), texel_type(0));
+					Write(Texture, extent_type(i, j), Band.Layer, Band.Face, Level + 1, Texel);
+				}
+			});
 		}
 	}
 
@@ -95,21 +106,27 @@ namespace detail
 		filter_func const Filter = detail::get_filter<filter_func, detail::DIMENSION_3D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type, sampler_value_type>(FILTER_NEAREST, Min, false);
 		GLI_ASSERT(Filter);
 
-		for(size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
-		for(size_type Face = BaseFace; Face <= MaxFace; ++Face)
+		// Memory shared for copy on write is copied once here rather than by the first band writing it while other bands read it
+		Texture.data();
+
+		// Each level is filtered from the previous one, the bands of a level are independent
 		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
 		{
 			extent_type const& ExtentDst = Texture.extent(Level + 1);
 			normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
 
-			for(component_type k = 0; k < ExtentDst.z; ++k)
-			for(component_type j = 0; j < ExtentDst.y; ++j)
-			for(component_type i = 0; i < ExtentDst.x; ++i)
+			detail::for_each_image_band(detail::split_image_bands(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level + 1, Level + 1), [&](detail::image_band const& Band)
 			{
-				normalized_type const& SamplePosition(normalized_type(i, j, k) * Scale);
-				texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
-				Write(Texture, extent_type(i, j, k), Layer, Face, Level + 1, Texel);
-			}
+				for(component_type Row = Band.Begin; Row < Band.End; ++Row)
+				for(component_type i = 0; i < ExtentDst.x; ++i)
+				{
+					component_type const j = Row % ExtentDst.y;
+					component_type const k = Row / ExtentDst.y;
+					normalized_type const& SamplePosition(normalized_type(i, j, k) * Scale);
+					texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Band.Layer, Band.Face, static_cast<sampler_value_type>(Level), texel_type(0));
+					Write(Texture, extent_type(i, j, k), Band.Layer, Band.Face, Level + 1, Texel);
+				}
+			});
 		}
 	}
 }//namespace detail
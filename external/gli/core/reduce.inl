@@ -246,244 +246,66 @@ namespace detail
 namespace detail
 {
 	template <typename vec_type>
-	struct compute_reduce_1d
+	struct compute_reduce
 	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture1d::size_type size_type;
-		typedef texture1d::extent_type extent_type;
-		
-		static vec_type call(texture1d const& A, texture1d const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
+		typedef texture::size_type size_type;
+		typedef texture::extent_type extent_type;
 
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.template load<vec_type>(TexelIndex, 0),
-				B.template load<vec_type>(TexelIndex, 0)));
-			
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LevelIndex)));
-				}
-			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_1d_array
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture1d_array::size_type size_type;
-		typedef texture1d_array::extent_type extent_type;
-		
-		static vec_type call(texture1d_array const& A, texture1d_array const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.template load<vec_type>(TexelIndex, 0),
-				B.template load<vec_type>(TexelIndex, 0)));
-			
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LayerIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LayerIndex, LevelIndex)));
-				}
-			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_2d
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture2d::size_type size_type;
-		typedef texture2d::extent_type extent_type;
-		
-		static vec_type call(texture2d const& A, texture2d const& B, func_type TexelFunc, func_type ReduceFunc)
+		template <typename texel_func_type, typename reduce_func_type>
+		static vec_type call(texture const& A, texture const& B, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
 		{
 			GLI_ASSERT(all(equal(A.extent(), B.extent())));
 			GLI_ASSERT(A.levels() == B.levels());
 			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.template load<vec_type>(TexelIndex, 0),
-				B.template load<vec_type>(TexelIndex, 0)));
-			
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LevelIndex)));
-				}
-			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_2d_array
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture2d_array::size_type size_type;
-		typedef texture2d_array::extent_type extent_type;
-		
-		static vec_type call(texture2d_array const& A, texture2d_array const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.template load<vec_type>(TexelIndex, 0, 0),
-				B.template load<vec_type>(TexelIndex, 0, 0)));
-			
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LayerIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LayerIndex, LevelIndex)));
-				}
-			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_3d
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture3d::size_type size_type;
-		typedef texture3d::extent_type extent_type;
-		
-		static vec_type call(texture3d const& A, texture3d const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.template load<vec_type>(TexelIndex, 0),
-				B.template load<vec_type>(TexelIndex, 0)));
-			
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
+			GLI_ASSERT(!is_compressed(A.format()) && block_size(A.format()) == sizeof(vec_type));
+			GLI_ASSERT(block_size(B.format()) == sizeof(vec_type));
+			GLI_ASSERT(A.layout() == B.layout());
+
+			// Each band is reduced separately, its rows following each other in memory as a single span of texels
+			std::vector<image_band> const Bands(detail::split_image_bands(A, 0, A.layers() - 1, 0, A.faces() - 1, 0, A.levels() - 1));
+			std::vector<vec_type> BandResults(Bands.size());
+
+			default_executor()->parallel_for(Bands.size(), 1, [&](size_t Begin, size_t End)
 			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.z = 0; TexelIndex.z < TexelCount.z; ++TexelIndex.z)
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
+				for(size_t BandIndex = Begin; BandIndex < End; ++BandIndex)
 				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LevelIndex)));
+					image_band const& Band = Bands[BandIndex];
+					size_t const Width = static_cast<size_t>(A.extent(Band.Level).x);
+					size_t const First = Width * static_cast<size_t>(Band.Begin);
+					size_t const Count = Width * static_cast<size_t>(Band.End - Band.Begin);
+
+					vec_type const* const SpanA = A.data<vec_type>(Band.Layer, Band.Face, Band.Level) + First;
+					vec_type const* const SpanB = B.data<vec_type>(Band.Layer, Band.Face, Band.Level) + First;
+
+					vec_type Result(TexelFunc(SpanA[0], SpanB[0]));
+					for(size_t TexelIndex = 1; TexelIndex < Count; ++TexelIndex)
+						Result = ReduceFunc(Result, TexelFunc(SpanA[TexelIndex], SpanB[TexelIndex]));
+
+					BandResults[BandIndex] = Result;
 				}
-			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_cube
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture_cube::size_type size_type;
-		typedef texture_cube::extent_type extent_type;
-		
-		static vec_type call(texture_cube const& A, texture_cube const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
-				A.load<vec_type>(TexelIndex, 0, 0),
-				B.load<vec_type>(TexelIndex, 0, 0)));
-			
-			for(size_type FaceIndex = 0, FaceCount = A.faces(); FaceIndex < FaceCount; ++FaceIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
+			});
+
+			// The results of the bands are reduced by pairs, a tree which shape only depends on the number of bands
+			for(size_t Stride = 1; Stride < BandResults.size(); Stride *= 2)
 			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
+				size_t const PairCount = (BandResults.size() - Stride + 2 * Stride - 1) / (2 * Stride);
+
+				default_executor()->parallel_for(PairCount, 64, [&](size_t Begin, size_t End)
 				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, FaceIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, FaceIndex, LevelIndex)));
-				}
+					for(size_t PairIndex = Begin; PairIndex < End; ++PairIndex)
+					{
+						size_t const Index = PairIndex * 2 * Stride;
+						BandResults[Index] = ReduceFunc(BandResults[Index], BandResults[Index + Stride]);
+					}
+				});
 			}
-			
-			return Result;
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_reduce_cube_array
-	{
-		typedef typename reduce_func<vec_type>::type func_type;
-		typedef texture_cube_array::size_type size_type;
-		typedef texture_cube_array::extent_type extent_type;
-		
-		static vec_type call(texture_cube_array const& A, texture_cube_array const& B, func_type TexelFunc, func_type ReduceFunc)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			extent_type TexelIndex(0);
-			vec_type Result(TexelFunc(
+
+			extent_type const TexelIndex(0);
+			vec_type const Result(TexelFunc(
 				A.load<vec_type>(TexelIndex, 0, 0, 0),
-				B.load<vec_type>(TexelIndex, 0, 0 ,0)));
-			
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type FaceIndex = 0, FaceCount = A.faces(); FaceIndex < FaceCount; ++FaceIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Result = ReduceFunc(Result, TexelFunc(
-						A.template load<vec_type>(TexelIndex, LayerIndex, FaceIndex, LevelIndex),
-						B.template load<vec_type>(TexelIndex, LayerIndex, FaceIndex, LevelIndex)));
-				}
-			}
-			
-			return Result;
+				B.load<vec_type>(TexelIndex, 0, 0, 0)));
+
+			return BandResults.empty() ? Result : ReduceFunc(Result, BandResults[0]);
 		}
 	};
 }//namepsace detail
@@ -491,43 +313,85 @@ namespace detail
 template <typename vec_type>
 inline vec_type reduce(texture1d const& In0, texture1d const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_1d<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture1d const& In0, texture1d const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture1d_array const& In0, texture1d_array const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_1d_array<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture1d_array const& In0, texture1d_array const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture2d const& In0, texture2d const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_2d<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture2d const& In0, texture2d const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture2d_array const& In0, texture2d_array const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_2d_array<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture2d_array const& In0, texture2d_array const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture3d const& In0, texture3d const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_3d<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture3d const& In0, texture3d const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture_cube const& In0, texture_cube const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_cube<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture_cube const& In0, texture_cube const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 
 template <typename vec_type>
 inline vec_type reduce(texture_cube_array const& In0, texture_cube_array const& In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc)
 {
-	return detail::compute_reduce_cube_array<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
+}
+
+template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+inline vec_type reduce(texture_cube_array const& In0, texture_cube_array const& In1, texel_func_type const& TexelFunc, reduce_func_type const& ReduceFunc)
+{
+	return detail::compute_reduce<vec_type>::call(In0, In1, TexelFunc, ReduceFunc);
 }
 }//namespace gli
 
@@ -32,6 +32,12 @@ namespace gli
 			// row x col
 			glm::vec4 Texel[4][4];
 		};
+
+		// Texels to compress in a block, 8 bits UNORM components
+		struct texel_block4x4_rgba8 {
+			// row x col
+			glm::u8vec4 Texel[4][4];
+		};
 		
 		glm::vec4 decompress_dxt1(const dxt1_block &Block, const extent2d &BlockTexelCoord);
 		texel_block4x4 decompress_dxt1_block(const dxt1_block &Block);
@@ -42,6 +48,15 @@ namespace gli
 		glm::vec4 decompress_dxt5(const dxt5_block &Block, const extent2d &BlockTexelCoord);
 		texel_block4x4 decompress_dxt5_block(const dxt5_block &Block);
 
+		// Texels with an alpha under 128 are encoded transparent when Alpha is true.
+		dxt1_block compress_dxt1_block(const texel_block4x4_rgba8 &Block, bool Alpha, bool HighQuality);
+		dxt5_block compress_dxt5_block(const texel_block4x4_rgba8 &Block, bool HighQuality);
+
+		// Decompress to 8 bits components. Transparent texels are black with an alpha of 0 when Alpha is true, opaque black otherwise.
+		texel_block4x4_rgba8 decompress_dxt1_block_rgba8(const dxt1_block &Block, bool Alpha);
+		texel_block4x4_rgba8 decompress_dxt3_block_rgba8(const dxt3_block &Block);
+		texel_block4x4_rgba8 decompress_dxt5_block_rgba8(const dxt5_block &Block);
+
 	}//namespace detail
 }//namespace gli
 
@@ -1,4 +1,9 @@
 #include <glm/gtc/packing.hpp>
+#include <algorithm>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
 
 namespace gli
 {
@@ -203,5 +208,593 @@ namespace gli
 
 			return TexelBlock;
 		}
+
+		// Expand a RGB 5:6:5 color to 8 bits components
+		inline glm::u8vec4 expand_color565(uint16_t Color)
+		{
+			uint32_t const R = Color >> 11;
+			uint32_t const G = (Color >> 5) & 0x3F;
+			uint32_t const B = Color & 0x1F;
+			return glm::u8vec4((R << 3) | (R >> 2), (G << 2) | (G >> 4), (B << 3) | (B >> 2), 0);
+		}
+
+		// Round a color of [0, 255] components to RGB 5:6:5
+		inline uint16_t quantize_color565(const glm::vec3 &Color)
+		{
+			glm::vec3 const Clamped(glm::clamp(Color, 0.0f, 255.0f));
+			uint32_t const R = static_cast<uint32_t>(Clamped.r * (31.0f / 255.0f) + 0.5f);
+			uint32_t const G = static_cast<uint32_t>(Clamped.g * (63.0f / 255.0f) + 0.5f);
+			uint32_t const B = static_cast<uint32_t>(Clamped.b * (31.0f / 255.0f) + 0.5f);
+			return static_cast<uint16_t>((R << 11) | (G << 5) | B);
+		}
+
+		// Colors of a block in 4 colors mode (Count of 4) or in 3 colors and transparent mode (Count of 3)
+		inline void compute_dxt1_palette(uint16_t Color0, uint16_t Color1, int Count, glm::u8vec4 *Palette)
+		{
+			glm::ivec4 const C0(expand_color565(Color0));
+			glm::ivec4 const C1(expand_color565(Color1));
+
+			Palette[0] = glm::u8vec4(C0);
+			Palette[1] = glm::u8vec4(C1);
+			if(Count == 4)
+			{
+				Palette[2] = glm::u8vec4((C0 * 2 + C1 + 1) / 3);
+				Palette[3] = glm::u8vec4((C0 + C1 * 2 + 1) / 3);
+			}
+			else
+			{
+				Palette[2] = glm::u8vec4((C0 + C1 + 1) / 2);
+				Palette[3] = glm::u8vec4(0);
+			}
+		}
+
+		// Select for each texel the nearest of the Count first colors of Palette, ignoring alpha.
+		// Return the sum of the squared distances of the texels in Mask.
+		inline uint32_t select_dxt1_indices(const texel_block4x4_rgba8 &Block, const glm::u8vec4 *Palette, int Count, uint32_t Mask, uint32_t &Indices)
+		{
+			glm::u8vec4 const* Texels = &Block.Texel[0][0];
+			uint32_t Error = 0;
+			Indices = 0;
+
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				__m128i const Zero = _mm_setzero_si128();
+				__m128i const ColorMask = _mm_set1_epi32(0x00FFFFFF);
+
+				__m128i PaletteWide[4];
+				for(int i = 0; i < Count; ++i)
+					PaletteWide[i] = _mm_unpacklo_epi8(_mm_set1_epi32(Palette[i].r | (Palette[i].g << 8) | (Palette[i].b << 16)), Zero);
+
+				// The distances of the 4 texels of a row are computed together
+				for(int Row = 0; Row < 4; ++Row)
+				{
+					__m128i const RowTexels = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(Texels + Row * 4)), ColorMask);
+					__m128i const Lo = _mm_unpacklo_epi8(RowTexels, Zero);
+					__m128i const Hi = _mm_unpackhi_epi8(RowTexels, Zero);
+
+					__m128i Best = _mm_set1_epi32(0x7FFFFFFF);
+					__m128i BestIndex = Zero;
+					for(int i = 0; i < Count; ++i)
+					{
+						__m128i const DiffLo = _mm_sub_epi16(Lo, PaletteWide[i]);
+						__m128i const DiffHi = _mm_sub_epi16(Hi, PaletteWide[i]);
+						__m128 const SumLo = _mm_castsi128_ps(_mm_madd_epi16(DiffLo, DiffLo));
+						__m128 const SumHi = _mm_castsi128_ps(_mm_madd_epi16(DiffHi, DiffHi));
+
+						// Add the red and green sum to the blue sum of each texel
+						__m128i const Distance = _mm_add_epi32(
+							_mm_castps_si128(_mm_shuffle_ps(SumLo, SumHi, _MM_SHUFFLE(2, 0, 2, 0))),
+							_mm_castps_si128(_mm_shuffle_ps(SumLo, SumHi, _MM_SHUFFLE(3, 1, 3, 1))));
+
+						__m128i const Closer = _mm_cmplt_epi32(Distance, Best);
+						Best = _mm_or_si128(_mm_and_si128(Closer, Distance), _mm_andnot_si128(Closer, Best));
+						BestIndex = _mm_or_si128(_mm_and_si128(Closer, _mm_set1_epi32(i)), _mm_andnot_si128(Closer, BestIndex));
+					}
+
+					uint32_t Distances[4];
+					uint32_t RowIndices[4];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Distances), Best);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(RowIndices), BestIndex);
+
+					for(int Col = 0; Col < 4; ++Col)
+					{
+						int const Texel = Row * 4 + Col;
+						Indices |= RowIndices[Col] << (Texel * 2);
+						if(Mask & (1u << Texel))
+							Error += Distances[Col];
+					}
+				}
+#			else
+				for(int Texel = 0; Texel < 16; ++Texel)
+				{
+					uint32_t Best = 0x7FFFFFFF;
+					uint32_t BestIndex = 0;
+					for(int i = 0; i < Count; ++i)
+					{
+						glm::ivec3 const Diff(glm::ivec3(Texels[Texel]) - glm::ivec3(Palette[i]));
+						uint32_t const Distance = static_cast<uint32_t>(Diff.x * Diff.x + Diff.y * Diff.y + Diff.z * Diff.z);
+						if(Distance < Best)
+						{
+							Best = Distance;
+							BestIndex = static_cast<uint32_t>(i);
+						}
+					}
+
+					Indices |= BestIndex << (Texel * 2);
+					if(Mask & (1u << Texel))
+						Error += Best;
+				}
+#			endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+			return Error;
+		}
+
+		struct dxt1_fit
+		{
+			uint16_t Color0;
+			uint16_t Color1;
+			uint32_t Indices;
+			uint32_t Error;
+		};
+
+		// Replace the endpoints of Fit if Color0 and Color1 encode the texels in Mask with a lower error
+		inline bool try_dxt1_endpoints(const texel_block4x4_rgba8 &Block, uint16_t Color0, uint16_t Color1, int Count, uint32_t Mask, dxt1_fit &Fit)
+		{
+			glm::u8vec4 Palette[4];
+			compute_dxt1_palette(Color0, Color1, Count, Palette);
+
+			uint32_t Indices = 0;
+			uint32_t const Error = select_dxt1_indices(Block, Palette, Count, Mask, Indices);
+			if(Error >= Fit.Error)
+				return false;
+
+			Fit.Color0 = Color0;
+			Fit.Color1 = Color1;
+			Fit.Indices = Indices;
+			Fit.Error = Error;
+			return true;
+		}
+
+		// Endpoints on the diagonal of the bounding box of the texels in Mask following the correlation of the components, inset to reduce the error
+		inline void compute_dxt1_box_endpoints(const texel_block4x4_rgba8 &Block, uint32_t Mask, glm::vec3 &Endpoint0, glm::vec3 &Endpoint1)
+		{
+			glm::vec3 Min(255.0f);
+			glm::vec3 Max(0.0f);
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+				glm::vec3 const Color(Block.Texel[Texel / 4][Texel % 4]);
+				Min = glm::min(Min, Color);
+				Max = glm::max(Max, Color);
+			}
+
+			glm::vec3 const Center((Min + Max) * 0.5f);
+			float CovarianceRG = 0.0f;
+			float CovarianceBG = 0.0f;
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+				glm::vec3 const Diff(glm::vec3(Block.Texel[Texel / 4][Texel % 4]) - Center);
+				CovarianceRG += Diff.r * Diff.g;
+				CovarianceBG += Diff.b * Diff.g;
+			}
+
+			if(CovarianceRG < 0.0f)
+				std::swap(Min.r, Max.r);
+			if(CovarianceBG < 0.0f)
+				std::swap(Min.b, Max.b);
+
+			glm::vec3 const Inset((Max - Min) / 16.0f);
+			Endpoint0 = Max - Inset;
+			Endpoint1 = Min + Inset;
+		}
+
+		// Endpoints at the extremities of the projection of the texels in Mask on their principal axis
+		inline void compute_dxt1_pca_endpoints(const texel_block4x4_rgba8 &Block, uint32_t Mask, glm::vec3 &Endpoint0, glm::vec3 &Endpoint1)
+		{
+			glm::vec3 Mean(0.0f);
+			float Count = 0.0f;
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+				Mean += glm::vec3(Block.Texel[Texel / 4][Texel % 4]);
+				Count += 1.0f;
+			}
+			Mean /= Count;
+
+			glm::mat3 Covariance(0.0f);
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+				glm::vec3 const Diff(glm::vec3(Block.Texel[Texel / 4][Texel % 4]) - Mean);
+				Covariance += glm::outerProduct(Diff, Diff);
+			}
+
+			// Power iterations from the column of the largest variance
+			int const Largest = Covariance[0][0] >= Covariance[1][1] && Covariance[0][0] >= Covariance[2][2] ? 0 : (Covariance[1][1] >= Covariance[2][2] ? 1 : 2);
+			glm::vec3 Axis(Covariance[Largest]);
+			for(int Iteration = 0; Iteration < 8 && glm::dot(Axis, Axis) > 1e-6f; ++Iteration)
+				Axis = Covariance * glm::normalize(Axis);
+
+			Endpoint0 = Endpoint1 = Mean;
+			if(glm::dot(Axis, Axis) <= 1e-6f)
+				return;
+			Axis = glm::normalize(Axis);
+
+			float MinProjection = 0.0f;
+			float MaxProjection = 0.0f;
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+				float const Projection = glm::dot(glm::vec3(Block.Texel[Texel / 4][Texel % 4]) - Mean, Axis);
+				MinProjection = glm::min(MinProjection, Projection);
+				MaxProjection = glm::max(MaxProjection, Projection);
+			}
+
+			Endpoint0 = Mean + Axis * MaxProjection;
+			Endpoint1 = Mean + Axis * MinProjection;
+		}
+
+		// Endpoints minimizing the squared error of the texels in Mask for the indices of Fit, false if the indices don't define them
+		inline bool refine_dxt1_endpoints(const texel_block4x4_rgba8 &Block, int Count, uint32_t Mask, const dxt1_fit &Fit, glm::vec3 &Endpoint0, glm::vec3 &Endpoint1)
+		{
+			// Weight of Endpoint0 for each index
+			static const float Weights4[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+			static const float Weights3[4] = {1.0f, 0.0f, 1.0f / 2.0f, 0.0f};
+			const float *Weights = Count == 4 ? Weights4 : Weights3;
+
+			float AA = 0.0f, AB = 0.0f, BB = 0.0f;
+			glm::vec3 AX(0.0f), BX(0.0f);
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				if(!(Mask & (1u << Texel)))
+					continue;
+
+				float const A = Weights[(Fit.Indices >> (Texel * 2)) & 0x3];
+				float const B = 1.0f - A;
+				glm::vec3 const Color(Block.Texel[Texel / 4][Texel % 4]);
+
+				AA += A * A;
+				AB += A * B;
+				BB += B * B;
+				AX += A * Color;
+				BX += B * Color;
+			}
+
+			float const Determinant = AA * BB - AB * AB;
+			if(glm::abs(Determinant) < 1e-6f)
+				return false;
+
+			Endpoint0 = (AX * BB - BX * AB) / Determinant;
+			Endpoint1 = (BX * AA - AX * AB) / Determinant;
+			return true;
+		}
+
+		// Move the endpoints of Fit by steps of one unit of a 5:6:5 component while it lowers the error
+		inline void search_dxt1_endpoints(const texel_block4x4_rgba8 &Block, int Count, uint32_t Mask, dxt1_fit &Fit)
+		{
+			static const uint16_t Steps[3] = {1 << 11, 1 << 5, 1};
+			static const uint16_t Masks[3] = {0x1F << 11, 0x3F << 5, 0x1F};
+
+			for(int Pass = 0; Pass < 8; ++Pass)
+			{
+				bool Lowered = false;
+				for(int Endpoint = 0; Endpoint < 2; ++Endpoint)
+				for(int Component = 0; Component < 3; ++Component)
+				{
+					uint16_t const Color = Endpoint == 0 ? Fit.Color0 : Fit.Color1;
+					uint16_t const Value = Color & Masks[Component];
+
+					uint16_t Candidates[2];
+					int CandidateCount = 0;
+					if(Value != 0)
+						Candidates[CandidateCount++] = static_cast<uint16_t>(Color - Steps[Component]);
+					if(Value != Masks[Component])
+						Candidates[CandidateCount++] = static_cast<uint16_t>(Color + Steps[Component]);
+
+					for(int i = 0; i < CandidateCount; ++i)
+					{
+						if(Endpoint == 0)
+							Lowered |= try_dxt1_endpoints(Block, Candidates[i], Fit.Color1, Count, Mask, Fit);
+						else
+							Lowered |= try_dxt1_endpoints(Block, Fit.Color0, Candidates[i], Count, Mask, Fit);
+					}
+				}
+
+				if(!Lowered)
+					break;
+			}
+		}
+
+		// Encode the colors of a block in 4 colors mode (Count of 4) or in 3 colors and transparent mode (Count of 3),
+		// the texels out of Mask being transparent.
+		inline dxt1_block compress_dxt1_colors(const texel_block4x4_rgba8 &Block, int Count, uint32_t Mask, bool HighQuality)
+		{
+			dxt1_fit Fit = {0, 0, 0, 0xFFFFFFFF};
+
+			if(Mask != 0)
+			{
+				glm::vec3 Endpoint0, Endpoint1;
+				compute_dxt1_box_endpoints(Block, Mask, Endpoint0, Endpoint1);
+				try_dxt1_endpoints(Block, quantize_color565(Endpoint0), quantize_color565(Endpoint1), Count, Mask, Fit);
+
+				if(HighQuality)
+				{
+					compute_dxt1_pca_endpoints(Block, Mask, Endpoint0, Endpoint1);
+					try_dxt1_endpoints(Block, quantize_color565(Endpoint0), quantize_color565(Endpoint1), Count, Mask, Fit);
+
+					for(int Iteration = 0; Iteration < 2; ++Iteration)
+						if(!refine_dxt1_endpoints(Block, Count, Mask, Fit, Endpoint0, Endpoint1) ||
+							!try_dxt1_endpoints(Block, quantize_color565(Endpoint0), quantize_color565(Endpoint1), Count, Mask, Fit))
+							break;
+
+					search_dxt1_endpoints(Block, Count, Mask, Fit);
+				}
+			}
+
+			// The order of the endpoints selects the mode
+			uint32_t Indices = Fit.Indices;
+			if(Count == 4)
+			{
+				if(Fit.Color0 < Fit.Color1)
+				{
+					std::swap(Fit.Color0, Fit.Color1);
+					Indices ^= 0x55555555;
+				}
+				else if(Fit.Color0 == Fit.Color1)
+					Indices = 0;
+			}
+			else
+			{
+				if(Fit.Color0 > Fit.Color1)
+				{
+					std::swap(Fit.Color0, Fit.Color1);
+					Indices ^= ~(Indices >> 1) & 0x55555555;
+				}
+
+				for(int Texel = 0; Texel < 16; ++Texel)
+					if(!(Mask & (1u << Texel)))
+						Indices |= 0x3u << (Texel * 2);
+			}
+
+			dxt1_block Result;
+			Result.Color0 = Fit.Color0;
+			Result.Color1 = Fit.Color1;
+			for(int Row = 0; Row < 4; ++Row)
+				Result.Row[Row] = static_cast<uint8_t>(Indices >> (Row * 8));
+			return Result;
+		}
+
+		// Values of a single channel block, 6 interpolated values when Channel0 > Channel1, 4 and the extremes otherwise
+		inline void compute_single_channel_palette(uint8_t Channel0, uint8_t Channel1, int *Palette)
+		{
+			Palette[0] = Channel0;
+			Palette[1] = Channel1;
+			if(Channel0 > Channel1)
+			{
+				for(int i = 1; i < 7; ++i)
+					Palette[i + 1] = ((7 - i) * Channel0 + i * Channel1 + 3) / 7;
+			}
+			else
+			{
+				for(int i = 1; i < 5; ++i)
+					Palette[i + 1] = ((5 - i) * Channel0 + i * Channel1 + 2) / 5;
+				Palette[6] = 0;
+				Palette[7] = 255;
+			}
+		}
+
+		// Select for each value the nearest value of the palette, returning the sum of the squared distances
+		inline uint32_t select_single_channel_indices(const uint8_t *Values, uint8_t Channel0, uint8_t Channel1, uint64_t &Bitmap)
+		{
+			int Palette[8];
+			compute_single_channel_palette(Channel0, Channel1, Palette);
+
+			uint32_t Error = 0;
+			Bitmap = 0;
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				int Best = 0x7FFFFFFF;
+				uint64_t BestIndex = 0;
+				for(int i = 0; i < 8; ++i)
+				{
+					int const Distance = (Values[Texel] - Palette[i]) * (Values[Texel] - Palette[i]);
+					if(Distance < Best)
+					{
+						Best = Distance;
+						BestIndex = static_cast<uint64_t>(i);
+					}
+				}
+
+				Bitmap |= BestIndex << (Texel * 3);
+				Error += static_cast<uint32_t>(Best);
+			}
+
+			return Error;
+		}
+
+		// Encode a channel of a block, using the 4 interpolated values mode only if Interpolate4 is true
+		inline void compress_single_channel(const texel_block4x4_rgba8 &Block, int Channel, bool Interpolate4, bool HighQuality, uint8_t &Channel0, uint8_t &Channel1, uint8_t *ChannelBitmap)
+		{
+			uint8_t Values[16];
+			int Min = 255, Max = 0;
+			int InnerMin = 255, InnerMax = 0;
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				Values[Texel] = Block.Texel[Texel / 4][Texel % 4][Channel];
+				Min = glm::min(Min, static_cast<int>(Values[Texel]));
+				Max = glm::max(Max, static_cast<int>(Values[Texel]));
+				if(Values[Texel] != 0 && Values[Texel] != 255)
+				{
+					InnerMin = glm::min(InnerMin, static_cast<int>(Values[Texel]));
+					InnerMax = glm::max(InnerMax, static_cast<int>(Values[Texel]));
+				}
+			}
+
+			Channel0 = static_cast<uint8_t>(Max);
+			Channel1 = static_cast<uint8_t>(Min);
+			uint64_t Bitmap = 0;
+			uint32_t Error = select_single_channel_indices(Values, Channel0, Channel1, Bitmap);
+
+			if(HighQuality)
+			{
+				// Search the endpoints inset from the extremes
+				int const Range = glm::min((Max - Min) / 4, 4);
+				for(int Inset0 = 0; Inset0 <= Range; ++Inset0)
+				for(int Inset1 = 0; Inset1 <= Range; ++Inset1)
+				{
+					uint8_t const Candidate0 = static_cast<uint8_t>(Max - Inset0);
+					uint8_t const Candidate1 = static_cast<uint8_t>(Min + Inset1);
+					if(Candidate0 <= Candidate1 || (Inset0 == 0 && Inset1 == 0))
+						continue;
+
+					uint64_t CandidateBitmap = 0;
+					uint32_t const CandidateError = select_single_channel_indices(Values, Candidate0, Candidate1, CandidateBitmap);
+					if(CandidateError < Error)
+					{
+						Channel0 = Candidate0;
+						Channel1 = Candidate1;
+						Bitmap = CandidateBitmap;
+						Error = CandidateError;
+					}
+				}
+
+				// Values of 0 and 255 are exact in the 4 interpolated values mode
+				if(Interpolate4 && InnerMin <= InnerMax)
+				{
+					uint64_t CandidateBitmap = 0;
+					uint32_t const CandidateError = select_single_channel_indices(Values, static_cast<uint8_t>(InnerMin), static_cast<uint8_t>(InnerMax), CandidateBitmap);
+					if(CandidateError < Error)
+					{
+						Channel0 = static_cast<uint8_t>(InnerMin);
+						Channel1 = static_cast<uint8_t>(InnerMax);
+						Bitmap = CandidateBitmap;
+						Error = CandidateError;
+					}
+				}
+			}
+
+			for(int i = 0; i < 6; ++i)
+				ChannelBitmap[i] = static_cast<uint8_t>(Bitmap >> (i * 8));
+		}
+
+		inline dxt1_block compress_dxt1_block(const texel_block4x4_rgba8 &Block, bool Alpha, bool HighQuality)
+		{
+			uint32_t Mask = 0xFFFF;
+			if(Alpha)
+			{
+				Mask = 0;
+				for(int Texel = 0; Texel < 16; ++Texel)
+					if(Block.Texel[Texel / 4][Texel % 4].a >= 128)
+						Mask |= 1u << Texel;
+			}
+
+			return compress_dxt1_colors(Block, Mask == 0xFFFF ? 4 : 3, Mask, HighQuality);
+		}
+
+		inline dxt5_block compress_dxt5_block(const texel_block4x4_rgba8 &Block, bool HighQuality)
+		{
+			dxt1_block const Color = compress_dxt1_colors(Block, 4, 0xFFFF, HighQuality);
+
+			dxt5_block Result;
+			Result.Color0 = Color.Color0;
+			Result.Color1 = Color.Color1;
+			for(int Row = 0; Row < 4; ++Row)
+				Result.Row[Row] = Color.Row[Row];
+			compress_single_channel(Block, 3, false, HighQuality, Result.Alpha[0], Result.Alpha[1], Result.AlphaBitmap);
+			return Result;
+		}
+
+		// Set the colors of the texels of a block to the colors of Palette selected by their 2 bits indices
+		inline void expand_dxt1_indices(const uint8_t *Rows, const glm::u8vec4 *Palette, texel_block4x4_rgba8 &Result)
+		{
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				__m128i const Zero = _mm_setzero_si128();
+				__m128i const LowBits = _mm_set_epi32(1 << 6, 1 << 4, 1 << 2, 1 << 0);
+				__m128i const HighBits = _mm_set_epi32(2 << 6, 2 << 4, 2 << 2, 2 << 0);
+
+				__m128i Colors[4];
+				for(int i = 0; i < 4; ++i)
+					Colors[i] = _mm_set1_epi32(Palette[i].r | (Palette[i].g << 8) | (Palette[i].b << 16) | (Palette[i].a << 24));
+
+				for(int Row = 0; Row < 4; ++Row)
+				{
+					__m128i const Bits = _mm_set1_epi32(Rows[Row]);
+					__m128i const LowClear = _mm_cmpeq_epi32(_mm_and_si128(Bits, LowBits), Zero);
+					__m128i const HighClear = _mm_cmpeq_epi32(_mm_and_si128(Bits, HighBits), Zero);
+
+					__m128i const Colors01 = _mm_or_si128(_mm_and_si128(LowClear, Colors[0]), _mm_andnot_si128(LowClear, Colors[1]));
+					__m128i const Colors23 = _mm_or_si128(_mm_and_si128(LowClear, Colors[2]), _mm_andnot_si128(LowClear, Colors[3]));
+					__m128i const Texels = _mm_or_si128(_mm_and_si128(HighClear, Colors01), _mm_andnot_si128(HighClear, Colors23));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&Result.Texel[Row][0]), Texels);
+				}
+#			else
+				for(int Row = 0; Row < 4; ++Row)
+				for(int Col = 0; Col < 4; ++Col)
+					Result.Texel[Row][Col] = Palette[(Rows[Row] >> (Col * 2)) & 0x3];
+#			endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+		}
+
+		// Set a channel of the texels of a block to the values of Palette selected by their 3 bits indices
+		inline void expand_single_channel_indices(const uint8_t *ChannelBitmap, const int *Palette, int Channel, texel_block4x4_rgba8 &Result)
+		{
+			uint64_t Bitmap = ChannelBitmap[0] | (ChannelBitmap[1] << 8) | (ChannelBitmap[2] << 16);
+			Bitmap |= uint64_t(ChannelBitmap[3] | (ChannelBitmap[4] << 8) | (ChannelBitmap[5] << 16)) << 24;
+
+			uint8_t Values[8];
+			for(int i = 0; i < 8; ++i)
+				Values[i] = static_cast<uint8_t>(Palette[i]);
+
+			uint8_t* Dst = &Result.Texel[0][0].x + Channel;
+			for(int Texel = 0; Texel < 16; ++Texel, Bitmap >>= 3)
+				Dst[Texel * 4] = Values[Bitmap & 0x7];
+		}
+
+		inline texel_block4x4_rgba8 decompress_dxt1_block_rgba8(const dxt1_block &Block, bool Alpha)
+		{
+			int const Count = Block.Color0 > Block.Color1 ? 4 : 3;
+
+			glm::u8vec4 Palette[4];
+			compute_dxt1_palette(Block.Color0, Block.Color1, Count, Palette);
+			for(int i = 0; i < 4; ++i)
+				Palette[i].a = i < Count || !Alpha ? 255 : 0;
+
+			texel_block4x4_rgba8 Result;
+			expand_dxt1_indices(Block.Row, Palette, Result);
+			return Result;
+		}
+
+		inline texel_block4x4_rgba8 decompress_dxt3_block_rgba8(const dxt3_block &Block)
+		{
+			glm::u8vec4 Palette[4];
+			compute_dxt1_palette(Block.Color0, Block.Color1, 4, Palette);
+
+			texel_block4x4_rgba8 Result;
+			expand_dxt1_indices(Block.Row, Palette, Result);
+
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+				Result.Texel[Row][Col].a = static_cast<uint8_t>(((Block.AlphaRow[Row] >> (Col * 4)) & 0xF) * 17);
+			return Result;
+		}
+
+		inline texel_block4x4_rgba8 decompress_dxt5_block_rgba8(const dxt5_block &Block)
+		{
+			glm::u8vec4 Palette[4];
+			compute_dxt1_palette(Block.Color0, Block.Color1, 4, Palette);
+
+			texel_block4x4_rgba8 Result;
+			expand_dxt1_indices(Block.Row, Palette, Result);
+
+			int AlphaPalette[8];
+			compute_single_channel_palette(Block.Alpha[0], Block.Alpha[1], AlphaPalette);
+			expand_single_channel_indices(Block.AlphaBitmap, AlphaPalette, 3, Result);
+			return Result;
+		}
 	}//namespace detail
 }//namespace gli
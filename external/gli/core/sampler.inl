@@ -13,6 +13,7 @@ namespace detail
 
 	inline sampler::sampler(wrap Wrap, filter Mip, filter Min)
 		: Wrap(get_func(Wrap))
+		, WrapMode(Wrap)
 		, Mip(Mip)
 		, Min(Min)
 	{}
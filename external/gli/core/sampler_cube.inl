@@ -61,6 +61,16 @@ namespace gli
 		return this->Filter(this->Texture, this->Convert.Fetch, SampleCoordWrap, size_type(0), Face, Level, this->BorderColor);
 	}
 
+	template <typename T, qualifier P>
+	inline void sampler_cube<T, P>::texture_lod(normalized_type const* SampleCoords, size_type Face, level_type const* Levels, texel_type* Texels, size_type Count) const
+	{
+		GLI_ASSERT(!this->Texture.empty());
+		GLI_ASSERT(std::numeric_limits<T>::is_iec559);
+		GLI_ASSERT(this->Convert.Fetch);
+
+		detail::texture_lod_batch(this->Texture, this->Convert.Fetch, this->WrapMode, this->Mip, this->Min, this->BorderColor, size_type(0), Face, SampleCoords, Levels, Texels, Count);
+	}
+
 	template <typename T, qualifier P>
 	inline void sampler_cube<T, P>::generate_mipmaps(filter Minification)
 	{
@@ -40,78 +40,114 @@ namespace detail
 			return (DXFormat.DDPixelFormat & dx::DDPF_FOURCC) ? DXFormat.D3DFormat : dx::D3DFMT_UNKNOWN;
 		}
 	}
-}//namespace detail
 
-	inline bool save_dds(texture const& Texture, std::vector<char>& Memory)
+	// Gather the headers and the images of a linear texture in the DDS layout, the images referenced in place
+	inline void gather_dds(texture const& Texture, write_list& List)
 	{
-		if(Texture.empty())
-			return false;
+		GLI_ASSERT(Texture.layout() == STORAGE_LAYOUT_LINEAR);
 
 		dx DX;
 		dx::format const& DXFormat = DX.translate(Texture.format());
 
 		bool const RequireDX10Header = DXFormat.D3DFormat == dx::D3DFMT_GLI1 || DXFormat.D3DFormat == dx::D3DFMT_DX10 || is_target_array(Texture.target()) || is_target_1d(Texture.target());
 
-		Memory.resize(Texture.size() + sizeof(detail::FOURCC_DDS) + sizeof(detail::dds_header) + (RequireDX10Header ? sizeof(detail::dds_header10) : 0));
+		dds_header Header;
+		std::memset(&Header, 0, sizeof(Header));
 
-		memcpy(&Memory[0], detail::FOURCC_DDS, sizeof(detail::FOURCC_DDS));
-		std::size_t Offset = sizeof(detail::FOURCC_DDS);
+		formatInfo const& Desc = get_format_info(Texture.format());
 
-		detail::dds_header& Header = *reinterpret_cast<detail::dds_header*>(&Memory[0] + Offset);
-		Offset += sizeof(detail::dds_header);
-
-		detail::formatInfo const& Desc = detail::get_format_info(Texture.format());
-
-		std::uint32_t Caps = detail::DDSD_CAPS | detail::DDSD_WIDTH | detail::DDSD_PIXELFORMAT | detail::DDSD_MIPMAPCOUNT;
-		Caps |= !is_target_1d(Texture.target()) ? detail::DDSD_HEIGHT : 0;
-		Caps |= Texture.target() == TARGET_3D ? detail::DDSD_DEPTH : 0;
-		//Caps |= Storage.levels() > 1 ? detail::DDSD_MIPMAPCOUNT : 0;
-		Caps |= (Desc.Flags & detail::CAP_COMPRESSED_BIT) ? detail::DDSD_LINEARSIZE : detail::DDSD_PITCH;
+		std::uint32_t Caps = DDSD_CAPS | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT;
+		Caps |= !is_target_1d(Texture.target()) ? DDSD_HEIGHT : 0;
+		Caps |= Texture.target() == TARGET_3D ? DDSD_DEPTH : 0;
+		//Caps |= Storage.levels() > 1 ? DDSD_MIPMAPCOUNT : 0;
+		Caps |= (Desc.Flags & CAP_COMPRESSED_BIT) ? DDSD_LINEARSIZE : DDSD_PITCH;
 
 		memset(Header.Reserved1, 0, sizeof(Header.Reserved1));
 		memset(Header.Reserved2, 0, sizeof(Header.Reserved2));
-		Header.Size = sizeof(detail::dds_header);
+		Header.Size = sizeof(dds_header);
 		Header.Flags = Caps;
 		Header.Width = static_cast<std::uint32_t>(Texture.extent().x);
 		Header.Height = static_cast<std::uint32_t>(Texture.extent().y);
-		Header.Pitch = static_cast<std::uint32_t>((Desc.Flags & detail::CAP_COMPRESSED_BIT) ? Texture.size() / Texture.faces() : 32);
+		Header.Pitch = static_cast<std::uint32_t>((Desc.Flags & CAP_COMPRESSED_BIT) ? Texture.size() / Texture.faces() : 32);
 		Header.Depth = static_cast<std::uint32_t>(Texture.extent().z > 1 ? Texture.extent().z : 0);
 		Header.MipMapLevels = static_cast<std::uint32_t>(Texture.levels());
-		Header.Format.size = sizeof(detail::dds_pixel_format);
+		Header.Format.size = sizeof(dds_pixel_format);
 		Header.Format.flags = RequireDX10Header ? dx::DDPF_FOURCC : DXFormat.DDPixelFormat;
-		Header.Format.fourCC = detail::get_fourcc(RequireDX10Header, Texture.format(), DXFormat);
-		Header.Format.bpp = static_cast<std::uint32_t>(detail::bits_per_pixel(Texture.format()));
+		Header.Format.fourCC = get_fourcc(RequireDX10Header, Texture.format(), DXFormat);
+		Header.Format.bpp = static_cast<std::uint32_t>(bits_per_pixel(Texture.format()));
 		Header.Format.Mask = DXFormat.Mask;
-		//Header.surfaceFlags = detail::DDSCAPS_TEXTURE | (Storage.levels() > 1 ? detail::DDSCAPS_MIPMAP : 0);
-		Header.SurfaceFlags = detail::DDSCAPS_TEXTURE | detail::DDSCAPS_MIPMAP;
+		//Header.surfaceFlags = DDSCAPS_TEXTURE | (Storage.levels() > 1 ? DDSCAPS_MIPMAP : 0);
+		Header.SurfaceFlags = DDSCAPS_TEXTURE | DDSCAPS_MIPMAP;
 		Header.CubemapFlags = 0;
 
 		// Cubemap
 		if(Texture.faces() > 1)
 		{
 			GLI_ASSERT(Texture.faces() == 6);
-			Header.CubemapFlags |= detail::DDSCAPS2_CUBEMAP_ALLFACES | detail::DDSCAPS2_CUBEMAP;
+			Header.CubemapFlags |= DDSCAPS2_CUBEMAP_ALLFACES | DDSCAPS2_CUBEMAP;
 		}
 
 		// Texture3D
 		if(Texture.extent().z > 1)
-			Header.CubemapFlags |= detail::DDSCAPS2_VOLUME;
+			Header.CubemapFlags |= DDSCAPS2_VOLUME;
+
+		List.append_copy(FOURCC_DDS, sizeof(FOURCC_DDS));
+		List.append_copy(&Header, sizeof(Header));
 
 		if(RequireDX10Header)
 		{
-			detail::dds_header10& Header10 = *reinterpret_cast<detail::dds_header10*>(&Memory[0] + Offset);
-			Offset += sizeof(detail::dds_header10);
+			dds_header10 Header10;
 
 			Header10.ArraySize = static_cast<std::uint32_t>(Texture.layers());
-			Header10.ResourceDimension = detail::get_dimension(Texture.target());
-			Header10.MiscFlag = 0;//Storage.levels() > 0 ? detail::D3D10_RESOURCE_MISC_GENERATE_MIPS : 0;
+			Header10.ResourceDimension = get_dimension(Texture.target());
+			Header10.MiscFlag = 0;//Storage.levels() > 0 ? D3D10_RESOURCE_MISC_GENERATE_MIPS : 0;
 			Header10.Format = DXFormat.DXGIFormat;
-			Header10.AlphaFlags = detail::DDS_ALPHA_MODE_UNKNOWN;
+			Header10.AlphaFlags = DDS_ALPHA_MODE_UNKNOWN;
+
+			List.append_copy(&Header10, sizeof(Header10));
 		}
 
-		std::memcpy(&Memory[0] + Offset, Texture.data(), Texture.size());
+		// The levels of a face follow each other, then the faces of a layer
+		for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
+		for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
+		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
+			List.append(Texture.data(Layer, Face, Level), Texture.size(Level));
+	}
+
+	template <typename sink_type>
+	inline bool save_dds(texture const& Texture, sink_type& Sink)
+	{
+		if(Texture.empty())
+			return false;
+
+		// Files store the texels by rows
+		texture const Linear(Texture.layout() == STORAGE_LAYOUT_LINEAR ? Texture : convert_layout(Texture, STORAGE_LAYOUT_LINEAR));
+
+		write_list List;
+		gather_dds(Linear, List);
 
-		return true;
+		return List.write(Sink);
+	}
+}//namespace detail
+
+	inline bool save_dds(texture const& Texture, std::vector<char>& Memory)
+	{
+		return detail::save_dds(Texture, Memory);
+	}
+
+	inline bool save_dds(texture const& Texture, FILE* File)
+	{
+		return detail::save_dds(Texture, File);
+	}
+
+	inline bool save_dds(texture const& Texture, int FileDescriptor)
+	{
+		return detail::save_dds(Texture, FileDescriptor);
+	}
+
+	inline bool save_dds(texture const& Texture, write_func const& Write)
+	{
+		return detail::save_dds(Texture, Write);
 	}
 
 	inline bool save_dds(texture const& Texture, char const* Filename)
@@ -123,13 +159,9 @@ namespace detail
 		if(!File)
 			return false;
 
-		std::vector<char> Memory;
-		bool const Result = save_dds(Texture, Memory);
-
-		std::fwrite(&Memory[0], 1, Memory.size(), File);
-		std::fclose(File);
+		bool const Result = save_dds(Texture, File);
 
-		return Result;
+		return std::fclose(File) == 0 && Result;
 	}
 
 	inline bool save_dds(texture const& Texture, std::string const& Filename)
@@ -11,6 +11,10 @@ namespace gli
 		if(Texture.empty())
 			return false;
 
+		// Files store the texels by rows
+		if(Texture.layout() != STORAGE_LAYOUT_LINEAR)
+			return save_kmg(convert_layout(Texture, STORAGE_LAYOUT_LINEAR), Memory);
+
 		Memory.resize(sizeof(detail::FOURCC_KMG100) + sizeof(detail::kmgHeader10) + Texture.size());
 
 		std::memcpy(&Memory[0], detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100));
@@ -6,47 +6,19 @@
 namespace gli{
 namespace detail
 {
-	inline texture::size_type compute_ktx_storage_size(texture const & Texture)
+	// Gather the header and the images of a linear texture in the KTX layout, the images referenced in place
+	inline void gather_ktx(texture const& Texture, write_list& List)
 	{
-		texture::size_type const BlockSize = block_size(Texture.format());
-		texture::size_type TotalSize = sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10);
-
-		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
-		{
-			TotalSize += sizeof(std::uint32_t);
-
-			for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
-			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
-			{
-				texture::size_type const FaceSize = Texture.size(Level);
-				texture::size_type const PaddedSize = std::max(BlockSize, glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4)));
-
-				TotalSize += PaddedSize;
-			}
-		}
-
-		return TotalSize;
-	}
-}//namespace detail
-
-	inline bool save_ktx(texture const& Texture, std::vector<char>& Memory)
-	{
-		if(Texture.empty())
-			return false;
+		GLI_ASSERT(Texture.layout() == STORAGE_LAYOUT_LINEAR);
 
 		gl GL(gl::PROFILE_KTX);
 		gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 		target const Target = Texture.target();
 
-		detail::formatInfo const& Desc = detail::get_format_info(Texture.format());
-
-		Memory.resize(detail::compute_ktx_storage_size(Texture));
-
-		std::memcpy(&Memory[0], detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10));
+		formatInfo const& Desc = get_format_info(Texture.format());
 
-		std::size_t Offset = sizeof(detail::FOURCC_KTX10);
-
-		detail::ktx_header10& Header = *reinterpret_cast<detail::ktx_header10*>(&Memory[0] + Offset);
+		ktx_header10 Header;
+		std::memset(&Header, 0, sizeof(Header));
 		Header.Endianness = 0x04030201;
 		Header.GLType = Format.Type;
 		Header.GLTypeSize = Format.Type == gl::TYPE_NONE ? 1 : Desc.BlockSize;
@@ -61,32 +33,60 @@ namespace detail
 		Header.NumberOfMipmapLevels = static_cast<std::uint32_t>(Texture.levels());
 		Header.BytesOfKeyValueData = 0;
 
-		Offset += sizeof(detail::ktx_header10);
+		List.append_copy(FOURCC_KTX10, sizeof(FOURCC_KTX10));
+		List.append_copy(&Header, sizeof(Header));
 
 		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
 		{
-			std::uint32_t& ImageSize = *reinterpret_cast<std::uint32_t*>(&Memory[0] + Offset);
-			Offset += sizeof(std::uint32_t);
+			texture::size_type const FaceSize = Texture.size(Level);
+			texture::size_type const PaddedSize = glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4));
+
+			std::uint32_t const ImageSize = static_cast<std::uint32_t>(PaddedSize * Texture.layers() * Texture.faces());
+			List.append_copy(&ImageSize, sizeof(ImageSize));
 
 			for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
 			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
 			{
-				texture::size_type const FaceSize = Texture.size(Level);
+				List.append(Texture.data(Layer, Face, Level), FaceSize);
+				List.append_copy(nullptr, PaddedSize - FaceSize);
+			}
+		}
+	}
 
-				std::memcpy(&Memory[0] + Offset, Texture.data(Layer, Face, Level), FaceSize);
+	template <typename sink_type>
+	inline bool save_ktx(texture const& Texture, sink_type& Sink)
+	{
+		if(Texture.empty())
+			return false;
 
-				texture::size_type const PaddedSize = glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4));
+		// Files store the texels by rows
+		texture const Linear(Texture.layout() == STORAGE_LAYOUT_LINEAR ? Texture : convert_layout(Texture, STORAGE_LAYOUT_LINEAR));
 
-				ImageSize += static_cast<std::uint32_t>(PaddedSize);
-				Offset += PaddedSize;
+		write_list List;
+		gather_ktx(Linear, List);
 
-				GLI_ASSERT(Offset <= Memory.size());
-			}
+		return List.write(Sink);
+	}
+}//namespace detail
 
-			ImageSize = glm::ceilMultiple(ImageSize, static_cast<std::uint32_t>(4));
-		}
+	inline bool save_ktx(texture const& Texture, std::vector<char>& Memory)
+	{
+		return detail::save_ktx(Texture, Memory);
+	}
+
+	inline bool save_ktx(texture const& Texture, FILE* File)
+	{
+		return detail::save_ktx(Texture, File);
+	}
 
-		return true;
+	inline bool save_ktx(texture const& Texture, int FileDescriptor)
+	{
+		return detail::save_ktx(Texture, FileDescriptor);
+	}
+
+	inline bool save_ktx(texture const& Texture, write_func const& Write)
+	{
+		return detail::save_ktx(Texture, Write);
 	}
 
 	inline bool save_ktx(texture const& Texture, char const* Filename)
@@ -98,13 +98,9 @@ namespace detail
 		if(!File)
 			return false;
 
-		std::vector<char> Memory;
-		bool const Result = save_ktx(Texture, Memory);
-
-		std::fwrite(&Memory[0], 1, Memory.size(), File);
-		std::fclose(File);
+		bool const Result = save_ktx(Texture, File);
 
-		return Result;
+		return std::fclose(File) == 0 && Result;
 	}
 
 	inline bool save_ktx(texture const& Texture, std::string const& Filename)
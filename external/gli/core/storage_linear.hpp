@@ -1,6 +1,7 @@
 #pragma once
 
 // STD
+#include <algorithm>
 #include <vector>
 #include <queue>
 #include <string>
@@ -8,9 +9,14 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 #include "../type.hpp"
 #include "../format.hpp"
+#include "../allocator.hpp"
+#include "../memory_usage.hpp"
+#include "hash_bytes.hpp"
 
 // GLM
 #include <glm/gtc/round.hpp>
@@ -35,33 +41,83 @@ namespace gli
 	public:
 		storage_linear();
 
+		/// Create a storage allocating its memory from Allocator, or the default allocator if null.
+		/// The images of a tiled storage have the size of the images of a linear storage.
+		/// The memory is accounted for under Target and the memory_tag of the calling thread, see current_memory_usage.
 		storage_linear(
 			format_type Format,
 			extent_type const & Extent,
 			size_type Layers,
 			size_type Faces,
-			size_type Levels);
+			size_type Levels,
+			std::shared_ptr<allocator> const& Allocator = nullptr,
+			storage_init Init = STORAGE_INIT_ZERO,
+			storage_layout Layout = STORAGE_LAYOUT_LINEAR,
+			target Target = static_cast<target>(TARGET_INVALID));
+
+		/// Create a storage referencing Memory instead of allocating its own.
+		/// Memory must be laid out like the storage would lay out its own data
+		/// and is kept alive for as long as the storage is.
+		storage_linear(
+			format_type Format,
+			extent_type const & Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<data_type> const& Memory);
+
+		/// Create a storage with the images of a subset of Storage. If the subset includes all the faces and levels of Storage,
+		/// the memory is shared with Storage until either storage is accessed for writing, otherwise the images are copied.
+		storage_linear(
+			storage_linear& Storage,
+			size_type BaseLayer, size_type MaxLayer,
+			size_type BaseFace, size_type MaxFace,
+			size_type BaseLevel, size_type MaxLevel);
 
 		bool empty() const;
 		size_type size() const; // Express is bytes
 		size_type layers() const;
 		size_type levels() const;
 		size_type faces() const;
+		storage_layout layout() const;
 
 		size_type block_size() const;
 		extent_type block_extent() const;
 		extent_type block_count(size_type Level) const;
 		extent_type extent(size_type Level) const;
 
+		/// Return the data for writing, discarding the cached hashes of the images.
+		/// Memory shared with other storages for copy on write is copied first.
 		data_type* data();
+
+		/// Return the data for reading. Safe to call while another thread writes the storage for the first time,
+		/// in which case it returns either the shared memory or the copy.
 		data_type const* const data() const;
 
+		/// Return a 64 bits hash of the content of an image, computed on first use then cached
+		/// until the data is accessed for writing
+		uint64 image_hash(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Return whether the hash of an image is cached, storing it in Hash if it is
+		bool cached_image_hash(size_type Layer, size_type Face, size_type Level, uint64& Hash) const;
+
+		/// Discard the cached hashes of the images
+		void invalidate_hashes();
+
+		/// Return the number of bytes of an image backed by physical memory, depending on the allocator of the storage
+		size_type resident_size(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Release the physical memory of an image if the allocator of the storage supports it, see allocator_sparse.
+		/// Memory shared with other storages for copy on write is copied first.
+		bool evict(size_type Layer, size_type Face, size_type Level);
+
 		/// Compute the relative memory offset to access the data for a specific layer, face and level
 		size_type base_offset(
 			size_type Layer,
 			size_type Face,
 			size_type Level) const;
 
+		/// Compute the offset in blocks of a block of an image, following the layout of the storage
 		size_type image_offset(extent1d const& Coord, extent1d const& Extent) const;
 
 		size_type image_offset(extent2d const& Coord, extent2d const& Extent) const;
@@ -91,7 +147,29 @@ namespace gli
 		extent_type const BlockCount;
 		extent_type const BlockExtent;
 		extent_type const Extent;
-		std::vector<data_type> Data;
+		storage_layout const Layout;
+		std::shared_ptr<data_type> Memory;
+		size_type MemorySize;
+
+		// Allocator of Memory, null when Memory is referenced from elsewhere
+		std::shared_ptr<allocator> Allocator;
+
+		// Buckets of the memory allocated by the storage in the memory usage
+		detail::memory_key MemoryKey;
+
+		// Shared by the storages sharing their memory until they are written
+		std::shared_ptr<void> CopyOnWrite;
+		mutable std::mutex CopyOnWriteMutex;
+		std::atomic<bool> CopyOnWritePending;
+
+		void detach_memory();
+
+		// Hashes of the images, 0 for the ones not computed yet.
+		// HashCached is set while hashes are cached or being computed, HashGeneration counts the invalidations.
+		mutable std::mutex HashMutex;
+		mutable std::vector<uint64> ImageHashes;
+		mutable std::atomic<bool> HashCached;
+		mutable uint64 HashGeneration;
 	};
 }//namespace gli
 
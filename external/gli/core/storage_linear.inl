@@ -1,5 +1,50 @@
-namespace gli
+namespace gli{
+namespace detail
 {
+	// Offset of a texel of a tiled image. Tiles are 4x4 texels, their texels in rows, and follow each other in rows of tiles.
+	// Tiles on the right and bottom edges are narrower or shorter so that tiled images are not larger than linear ones.
+	inline size_t tiled_image_offset(extent2d const& Coord, extent2d const& Extent)
+	{
+		size_t const TileX = static_cast<size_t>(Coord.x & ~3);
+		size_t const TileY = static_cast<size_t>(Coord.y & ~3);
+		size_t const TileWidth = std::min<size_t>(4, static_cast<size_t>(Extent.x) - TileX);
+		size_t const TileHeight = std::min<size_t>(4, static_cast<size_t>(Extent.y) - TileY);
+
+		return TileY * static_cast<size_t>(Extent.x) + TileX * TileHeight + static_cast<size_t>(Coord.y & 3) * TileWidth + static_cast<size_t>(Coord.x & 3);
+	}
+
+	// Offset of a texel of an image given its row of texels, the rows of the slices following each other
+	inline size_t layout_texel_offset(storage_layout Layout, extent3d const& Extent, int x, int Row)
+	{
+		int const Slice = Row / Extent.y;
+		int const Line = Row % Extent.y;
+		size_t const SliceOffset = static_cast<size_t>(Slice) * static_cast<size_t>(Extent.x) * static_cast<size_t>(Extent.y);
+
+		if(Layout == STORAGE_LAYOUT_TILED)
+			return SliceOffset + tiled_image_offset(extent2d(x, Line), extent2d(Extent));
+		return SliceOffset + static_cast<size_t>(Line) * static_cast<size_t>(Extent.x) + static_cast<size_t>(x);
+	}
+
+	// Allocate storage memory from Allocator, the deleter holds a reference to the allocator until the memory is returned
+	// and accounts for the deallocation in the buckets of the allocation
+	inline std::shared_ptr<storage_linear::data_type> allocate_storage_memory(std::shared_ptr<allocator> const& Allocator, size_t Size, memory_key const& Key)
+	{
+		storage_linear::data_type* const Pointer = static_cast<storage_linear::data_type*>(Allocator->allocate(Size));
+		if(!Pointer)
+			throw std::bad_alloc();
+
+		std::shared_ptr<storage_linear::data_type> Memory(Pointer, [Allocator, Size, Key](storage_linear::data_type* Pointer)
+		{
+			Allocator->deallocate(Pointer, Size);
+			memory_accounting_instance().deallocated(Key, Size);
+		});
+
+		memory_accounting_instance().allocated(Key, Size);
+
+		return Memory;
+	}
+}//namespace detail
+
 	inline storage_linear::storage_linear()
 		: Layers(0)
 		, Faces(0)
@@ -8,9 +53,15 @@ namespace gli
 		, BlockCount(0)
 		, BlockExtent(0)
 		, Extent(0)
+		, Layout(STORAGE_LAYOUT_LINEAR)
+		, MemorySize(0)
+		, MemoryKey(detail::make_memory_key(static_cast<gli::format>(FORMAT_INVALID), static_cast<gli::target>(TARGET_INVALID)))
+		, CopyOnWritePending(false)
+		, HashCached(false)
+		, HashGeneration(0)
 	{}
 
-	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels)
+	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels, std::shared_ptr<allocator> const& Allocator, storage_init Init, storage_layout Layout, target Target)
 		: Layers(Layers)
 		, Faces(Faces)
 		, Levels(Levels)
@@ -18,18 +69,108 @@ namespace gli
 		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
 		, BlockExtent(gli::block_extent(Format))
 		, Extent(Extent)
+		, Layout(Layout)
+		, MemorySize(0)
+		, MemoryKey(detail::make_memory_key(Format, Target))
+		, CopyOnWritePending(false)
+		, HashCached(false)
+		, HashGeneration(0)
 	{
 		GLI_ASSERT(Layers > 0);
 		GLI_ASSERT(Faces > 0);
 		GLI_ASSERT(Levels > 0);
 		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+		GLI_ASSERT(Layout == STORAGE_LAYOUT_LINEAR || !gli::is_compressed(Format));
 
-		this->Data.resize(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers, 0);
+		size_type const Size = this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers;
+
+		this->Allocator = Allocator ? Allocator : default_allocator();
+		this->Memory = detail::allocate_storage_memory(this->Allocator, Size, this->MemoryKey);
+		this->MemorySize = Size;
+
+		if(Init == STORAGE_INIT_ZERO && !this->Allocator->zeroed(Size))
+			std::memset(this->Memory.get(), 0, Size);
+	}
+
+	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels, std::shared_ptr<data_type> const& Memory)
+		: Layers(Layers)
+		, Faces(Faces)
+		, Levels(Levels)
+		, BlockSize(gli::block_size(Format))
+		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
+		, BlockExtent(gli::block_extent(Format))
+		, Extent(Extent)
+		, Layout(STORAGE_LAYOUT_LINEAR)
+		, Memory(Memory)
+		, MemorySize(0)
+		, MemoryKey(detail::make_memory_key(Format, static_cast<gli::target>(TARGET_INVALID)))
+		, CopyOnWritePending(false)
+		, HashCached(false)
+		, HashGeneration(0)
+	{
+		GLI_ASSERT(Layers > 0);
+		GLI_ASSERT(Faces > 0);
+		GLI_ASSERT(Levels > 0);
+		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+		GLI_ASSERT(Memory);
+
+		this->MemorySize = this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers;
+	}
+
+	inline storage_linear::storage_linear(storage_linear& Storage, size_type BaseLayer, size_type MaxLayer, size_type BaseFace, size_type MaxFace, size_type BaseLevel, size_type MaxLevel)
+		: Layers(MaxLayer - BaseLayer + 1)
+		, Faces(MaxFace - BaseFace + 1)
+		, Levels(MaxLevel - BaseLevel + 1)
+		, BlockSize(Storage.block_size())
+		, BlockCount(Storage.block_count(BaseLevel))
+		, BlockExtent(Storage.block_extent())
+		, Extent(Storage.extent(BaseLevel))
+		, Layout(Storage.layout())
+		, MemorySize(0)
+		, Allocator(Storage.Allocator)
+		, MemoryKey(detail::make_memory_key(Storage.MemoryKey.Format, Storage.MemoryKey.Target))
+		, CopyOnWritePending(false)
+		, HashCached(false)
+		, HashGeneration(0)
+	{
+		GLI_ASSERT(!Storage.empty());
+		GLI_ASSERT(BaseLayer <= MaxLayer && MaxLayer < Storage.layers());
+		GLI_ASSERT(BaseFace <= MaxFace && MaxFace < Storage.faces());
+		GLI_ASSERT(BaseLevel <= MaxLevel && MaxLevel < Storage.levels());
+
+		this->MemorySize = this->layer_size(0, this->Faces - 1, 0, this->Levels - 1) * this->Layers;
+
+		// Consecutive layers of all the faces and levels are laid out in memory like a storage of their own
+		if(this->Faces == Storage.faces() && this->Levels == Storage.levels())
+		{
+			std::lock_guard<std::mutex> Lock(Storage.CopyOnWriteMutex);
+			if(!Storage.CopyOnWrite)
+				Storage.CopyOnWrite = std::make_shared<bool>(true);
+
+			this->CopyOnWrite = Storage.CopyOnWrite;
+			this->Memory = std::shared_ptr<data_type>(Storage.Memory, Storage.Memory.get() + Storage.base_offset(BaseLayer, 0, 0));
+			this->CopyOnWritePending.store(true, std::memory_order_release);
+			Storage.CopyOnWritePending.store(true, std::memory_order_release);
+			return;
+		}
+
+		this->Memory = detail::allocate_storage_memory(this->Allocator ? this->Allocator : default_allocator(), this->MemorySize, this->MemoryKey);
+
+		// The levels of a face are contiguous
+		size_type const FaceSize = this->face_size(0, this->Levels - 1);
+		for(size_type Layer = 0; Layer < this->Layers; ++Layer)
+		for(size_type Face = 0; Face < this->Faces; ++Face)
+		{
+			std::memcpy(
+				this->Memory.get() + this->base_offset(Layer, Face, 0),
+				Storage.Memory.get() + Storage.base_offset(BaseLayer + Layer, BaseFace + Face, BaseLevel),
+				FaceSize);
+		}
 	}
 
 	inline bool storage_linear::empty() const
 	{
-		return this->Data.empty();
+		return this->MemorySize == 0;
 	}
 
 	inline storage_linear::size_type storage_linear::layers() const
@@ -42,6 +183,11 @@ namespace gli
 		return this->Faces;
 	}
 
+	inline storage_layout storage_linear::layout() const
+	{
+		return this->Layout;
+	}
+
 	inline storage_linear::size_type storage_linear::levels() const
 	{
 		return this->Levels;
@@ -75,21 +221,139 @@ namespace gli
 	{
 		GLI_ASSERT(!this->empty());
 
-		return static_cast<size_type>(this->Data.size());
+		return this->MemorySize;
 	}
 
 	inline storage_linear::data_type* storage_linear::data()
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		this->detach_memory();
+		this->invalidate_hashes();
+
+		return this->Memory.get();
 	}
 
 	inline storage_linear::data_type const* const storage_linear::data() const
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		// Memory is replaced under the lock when the storage is first written, see detach_memory
+		if(this->CopyOnWritePending.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> Lock(this->CopyOnWriteMutex);
+			return this->Memory.get();
+		}
+
+		return this->Memory.get();
+	}
+
+	inline uint64 storage_linear::image_hash(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		size_type const Index = (Layer * this->Faces + Face) * this->Levels + Level;
+
+		uint64 Generation = 0;
+		{
+			std::lock_guard<std::mutex> Lock(this->HashMutex);
+			if(!this->HashCached.load(std::memory_order_relaxed))
+			{
+				this->ImageHashes.assign(this->Layers * this->Faces * this->Levels, 0);
+				this->HashCached.store(true, std::memory_order_release);
+			}
+			else if(this->ImageHashes[Index] != 0)
+				return this->ImageHashes[Index];
+			Generation = this->HashGeneration;
+		}
+
+		// Hashed without holding the lock so that images are hashed concurrently
+		uint64 Hash = detail::hash_bytes(this->data() + this->base_offset(Layer, Face, Level), this->level_size(Level), 0);
+		Hash = Hash == 0 ? 1 : Hash;
+
+		// Not cached if the data was accessed for writing meanwhile, the hash may not match the content anymore
+		std::lock_guard<std::mutex> Lock(this->HashMutex);
+		if(Generation == this->HashGeneration)
+			this->ImageHashes[Index] = Hash;
+
+		return Hash;
+	}
+
+	inline bool storage_linear::cached_image_hash(size_type Layer, size_type Face, size_type Level, uint64& Hash) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		if(!this->HashCached.load(std::memory_order_acquire))
+			return false;
+
+		std::lock_guard<std::mutex> Lock(this->HashMutex);
+		if(this->ImageHashes.empty())
+			return false;
+
+		Hash = this->ImageHashes[(Layer * this->Faces + Face) * this->Levels + Level];
+		return Hash != 0;
+	}
+
+	inline void storage_linear::invalidate_hashes()
+	{
+		// Cheap check first, writing texels goes through here
+		if(!this->HashCached.load(std::memory_order_acquire))
+			return;
+
+		std::lock_guard<std::mutex> Lock(this->HashMutex);
+		this->ImageHashes.clear();
+		this->HashCached.store(false, std::memory_order_release);
+		++this->HashGeneration;
+	}
+
+	inline storage_linear::size_type storage_linear::resident_size(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		// Memory referenced from elsewhere is assumed resident
+		if(!this->Allocator)
+			return this->level_size(Level);
+
+		return this->Allocator->resident_size(this->data() + this->base_offset(Layer, Face, Level), this->level_size(Level));
+	}
+
+	inline bool storage_linear::evict(size_type Layer, size_type Face, size_type Level)
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		if(!this->Allocator)
+			return false;
+
+		// Pages shared with other storages are copied first, evicting them would change the other storages
+		data_type* const Data = this->data();
+
+		return this->Allocator->evict(Data + this->base_offset(Layer, Face, Level), this->level_size(Level));
+	}
+
+	inline void storage_linear::detach_memory()
+	{
+		// Cheap check first, writing texels goes through here
+		if(!this->CopyOnWritePending.load(std::memory_order_acquire))
+			return;
+
+		std::lock_guard<std::mutex> Lock(this->CopyOnWriteMutex);
+		if(!this->CopyOnWritePending.load(std::memory_order_relaxed))
+			return;
+
+		// The last storage referencing the memory keeps it, the other ones release it only once copied
+		if(this->CopyOnWrite.use_count() > 1)
+		{
+			std::shared_ptr<data_type> const Copy(detail::allocate_storage_memory(this->Allocator ? this->Allocator : default_allocator(), this->MemorySize, this->MemoryKey));
+			std::memcpy(Copy.get(), this->Memory.get(), this->MemorySize);
+			this->Memory = Copy;
+		}
+
+		this->CopyOnWrite.reset();
+		this->CopyOnWritePending.store(false, std::memory_order_release);
 	}
 
 	inline storage_linear::size_type storage_linear::base_offset(size_type Layer, size_type Face, size_type Level) const
@@ -116,12 +380,16 @@ namespace gli
 	inline storage_linear::size_type storage_linear::image_offset(extent2d const& Coord, extent2d const& Extent) const
 	{
 		GLI_ASSERT(glm::all(glm::lessThan(Coord, Extent)));
+		if(this->Layout == STORAGE_LAYOUT_TILED)
+			return detail::tiled_image_offset(Coord, Extent);
 		return static_cast<size_t>(Coord.x + Coord.y * Extent.x);
 	}
 
 	inline storage_linear::size_type storage_linear::image_offset(extent3d const& Coord, extent3d const& Extent) const
 	{
 		GLI_ASSERT(glm::all(glm::lessThan(Coord, Extent)));
+		if(this->Layout == STORAGE_LAYOUT_TILED)
+			return static_cast<storage_linear::size_type>(Coord.z * Extent.x * Extent.y) + detail::tiled_image_offset(extent2d(Coord), extent2d(Extent));
 		return static_cast<storage_linear::size_type>(Coord.x + Coord.y * Extent.x + Coord.z * Extent.x * Extent.y);
 	}
 
@@ -144,7 +412,22 @@ namespace gli
 			gli::size_t const OffsetDst = this->image_offset(BlockIndexDst + BlockIndex, this->extent(LevelDst)) * this->block_size();
 			storage_linear::data_type const* const DataSrc = ImageSrc + OffsetSrc;
 			storage_linear::data_type* DataDst = ImageDst + OffsetDst;
-			memcpy(DataDst, DataSrc, this->block_size() * BlockCount.x);
+
+			// The blocks of a row are contiguous in linear storages only
+			if(this->Layout == STORAGE_LAYOUT_LINEAR && StorageSrc.Layout == STORAGE_LAYOUT_LINEAR)
+			{
+				memcpy(DataDst, DataSrc, this->block_size() * BlockCount.x);
+				continue;
+			}
+
+			for(int BlockIndexX = 0; BlockIndexX < BlockCount.x; ++BlockIndexX)
+			{
+				extent_type const BlockIndexRow(BlockIndexX, BlockIndexY, BlockIndexZ);
+				memcpy(
+					ImageDst + this->image_offset(BlockIndexDst + BlockIndexRow, this->extent(LevelDst)) * this->block_size(),
+					ImageSrc + StorageSrc.image_offset(BlockIndexSrc + BlockIndexRow, StorageSrc.extent(LevelSrc)) * StorageSrc.block_size(),
+					this->block_size());
+			}
 		}
 	}
 
@@ -23,7 +23,57 @@ namespace gli
 		size_type Levels,
 		swizzles_type const& Swizzles
 	)
-		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels))
+		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels, nullptr, STORAGE_INIT_ZERO, STORAGE_LAYOUT_LINEAR, Target))
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Layers - 1)
+		, BaseFace(0), MaxFace(Faces - 1)
+		, BaseLevel(0), MaxLevel(Levels - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(Target != TARGET_CUBE || (Target == TARGET_CUBE && Extent.x == Extent.y));
+		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
+	}
+
+	inline texture::texture
+	(
+		target_type Target,
+		format_type Format,
+		extent_type const& Extent,
+		size_type Layers,
+		size_type Faces,
+		size_type Levels,
+		std::shared_ptr<allocator> const& Allocator,
+		storage_init Init,
+		swizzles_type const& Swizzles,
+		storage_layout Layout
+	)
+		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels, Allocator, Init, Layout, Target))
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Layers - 1)
+		, BaseFace(0), MaxFace(Faces - 1)
+		, BaseLevel(0), MaxLevel(Levels - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(Target != TARGET_CUBE || (Target == TARGET_CUBE && Extent.x == Extent.y));
+		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
+	}
+
+	inline texture::texture
+	(
+		target_type Target,
+		format_type Format,
+		extent_type const& Extent,
+		size_type Layers,
+		size_type Faces,
+		size_type Levels,
+		std::shared_ptr<data_type> const& Memory,
+		swizzles_type const& Swizzles
+	)
+		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels, Memory))
 		, Target(Target)
 		, Format(Format)
 		, BaseLayer(0), MaxLayer(Layers - 1)
@@ -93,6 +143,27 @@ namespace gli
 		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && this->layers() >= 1 && this->faces() >= 1 && this->extent().y >= 1 && this->extent().z == 1));
 	}
 
+	inline texture::texture
+	(
+		texture const& Texture,
+		copy_on_write
+	)
+		: Storage(std::make_shared<storage_type>(
+			*Texture.Storage,
+			Texture.base_layer(), Texture.max_layer(),
+			Texture.base_face(), Texture.max_face(),
+			Texture.base_level(), Texture.max_level()))
+		, Target(Texture.target())
+		, Format(Texture.format())
+		, BaseLayer(0), MaxLayer(Texture.layers() - 1)
+		, BaseFace(0), MaxFace(Texture.faces() - 1)
+		, BaseLevel(0), MaxLevel(Texture.levels() - 1)
+		, Swizzles(Texture.swizzles())
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(!Texture.empty());
+	}
+
 	inline bool texture::empty() const
 	{
 		if(this->Storage.get() == nullptr)
@@ -119,6 +190,13 @@ namespace gli
 		return ResultSwizzle;
 	}
 
+	inline storage_layout texture::layout() const
+	{
+		if(this->empty())
+			return STORAGE_LAYOUT_LINEAR;
+		return this->Storage->layout();
+	}
+
 	inline texture::size_type texture::base_layer() const
 	{
 		return this->BaseLayer;
@@ -206,14 +284,15 @@ namespace gli
 	{
 		GLI_ASSERT(!this->empty());
 
-		return this->Cache.get_base_address(0, 0, 0);
+		return this->Cache.get_base_address(this->Storage->data(), 0, 0, 0);
 	}
 
 	inline void const* texture::data() const
 	{
 		GLI_ASSERT(!this->empty());
 
-		return this->Cache.get_base_address(0, 0, 0);
+		storage_type const& Storage = *this->Storage;
+		return this->Cache.get_base_address(Storage.data(), 0, 0, 0);
 	}
 
 	template <typename gen_type>
@@ -237,7 +316,7 @@ namespace gli
 		GLI_ASSERT(!this->empty());
 		GLI_ASSERT(Layer >= 0 && Layer < this->layers() && Face >= 0 && Face < this->faces() && Level >= 0 && Level < this->levels());
 
-		return this->Cache.get_base_address(Layer, Face, Level);
+		return this->Cache.get_base_address(this->Storage->data(), Layer, Face, Level);
 	}
 
 	inline void const* const texture::data(size_type Layer, size_type Face, size_type Level) const
@@ -245,7 +324,8 @@ namespace gli
 		GLI_ASSERT(!this->empty());
 		GLI_ASSERT(Layer >= 0 && Layer < this->layers() && Face >= 0 && Face < this->faces() && Level >= 0 && Level < this->levels());
 
-		return this->Cache.get_base_address(Layer, Face, Level);
+		storage_type const& Storage = *this->Storage;
+		return this->Cache.get_base_address(Storage.data(), Layer, Face, Level);
 	}
 
 	template <typename gen_type>
@@ -264,6 +344,38 @@ namespace gli
 		return reinterpret_cast<gen_type const* const>(this->data(Layer, Face, Level));
 	}
 
+	inline uint64 texture::hash(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		return this->Storage->image_hash(this->base_layer() + Layer, this->base_face() + Face, this->base_level() + Level);
+	}
+
+	inline bool texture::cached_hash(size_type Layer, size_type Face, size_type Level, uint64& Hash) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		return this->Storage->cached_image_hash(this->base_layer() + Layer, this->base_face() + Face, this->base_level() + Level, Hash);
+	}
+
+	inline texture::size_type texture::resident_size(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		return this->Storage->resident_size(this->base_layer() + Layer, this->base_face() + Face, this->base_level() + Level);
+	}
+
+	inline bool texture::evict(size_type Layer, size_type Face, size_type Level)
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+
+		return this->Storage->evict(this->base_layer() + Layer, this->base_face() + Face, this->base_level() + Level);
+	}
+
 	inline texture::extent_type texture::extent(size_type Level) const
 	{
 		GLI_ASSERT(!this->empty());
@@ -343,10 +455,28 @@ namespace gli
 		GLI_ASSERT(LevelSrc < TextureSrc.levels());
 		GLI_ASSERT(LevelDst < this->levels());
 		
-		memcpy(
-			this->data(LayerDst, FaceDst, LevelDst),
-			TextureSrc.data(LayerSrc, FaceSrc, LevelSrc),
-			this->size(LevelDst));
+		glm::byte* const ImageDst = static_cast<glm::byte*>(this->data(LayerDst, FaceDst, LevelDst));
+		glm::byte const* const ImageSrc = static_cast<glm::byte const*>(TextureSrc.data(LayerSrc, FaceSrc, LevelSrc));
+
+		if(this->layout() == TextureSrc.layout())
+		{
+			memcpy(ImageDst, ImageSrc, this->size(LevelDst));
+			return;
+		}
+
+		// Images of different layouts are copied by runs of texels contiguous in both, the width of a tile
+		GLI_ASSERT(all(equal(this->extent(LevelDst), TextureSrc.extent(LevelSrc))));
+
+		extent_type const Extent(this->extent(LevelDst));
+		size_type const BlockSize = block_size(this->format());
+		for(int Row = 0, RowCount = Extent.y * Extent.z; Row < RowCount; ++Row)
+		for(int x = 0; x < Extent.x; x += 4)
+		{
+			memcpy(
+				ImageDst + detail::layout_texel_offset(this->layout(), Extent, x, Row) * BlockSize,
+				ImageSrc + detail::layout_texel_offset(TextureSrc.layout(), Extent, x, Row) * BlockSize,
+				static_cast<size_t>(std::min(4, Extent.x - x)) * BlockSize);
+		}
 	}
 
 	inline void texture::copy
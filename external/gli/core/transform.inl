@@ -2,213 +2,40 @@ namespace gli{
 namespace detail
 {
 	template <typename vec_type>
-	struct compute_transform_1d
+	struct compute_transform
 	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture1d::size_type size_type;
-		typedef texture1d::extent_type extent_type;
-		
-		static void call(texture1d& Output, texture1d const& A, texture1d const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LevelIndex)));
-				}
-			}
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_transform_1d_array
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture1d_array::size_type size_type;
-		typedef texture1d_array::extent_type extent_type;
-		
-		static void call(texture1d_array& Output, texture1d_array const& A, texture1d_array const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.layers() == B.layers());
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-			
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LayerIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LayerIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LayerIndex, LevelIndex)));
-				}
-			}
-		}
-	};
-	
-	template <typename vec_type>
-	struct compute_transform_2d
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture2d::size_type size_type;
-		typedef texture2d::extent_type extent_type;
-			
-		static void call(texture2d& Output, texture2d const& A, texture2d const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-				
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LevelIndex)));
-				}
-			}
-		}
-	};
-		
-	template <typename vec_type>
-	struct compute_transform_2d_array
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture2d_array::size_type size_type;
-		typedef texture2d_array::extent_type extent_type;
-		
-		static void call(texture2d_array& Output, texture2d_array const& A, texture2d_array const& B, func_type Func)
+		typedef texture::size_type size_type;
+		typedef texture::extent_type extent_type;
+
+		// The rows of a band follow each other in memory, each band is transformed as a single span of texels
+		template <typename func_type>
+		static void call(texture& Output, texture const& A, texture const& B, func_type const& Func)
 		{
 			GLI_ASSERT(all(equal(A.extent(), B.extent())));
 			GLI_ASSERT(A.layers() == B.layers());
+			GLI_ASSERT(A.faces() == B.faces());
 			GLI_ASSERT(A.levels() == B.levels());
 			GLI_ASSERT(A.size() == B.size());
-				
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LayerIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LayerIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LayerIndex, LevelIndex)));
-				}
-			}
-		}
-	};
+			GLI_ASSERT(!is_compressed(A.format()) && block_size(A.format()) == sizeof(vec_type));
+			GLI_ASSERT(block_size(B.format()) == sizeof(vec_type) && block_size(Output.format()) == sizeof(vec_type));
+			GLI_ASSERT(A.layout() == B.layout() && A.layout() == Output.layout());
 
-	template <typename vec_type>
-	struct compute_transform_3d
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture3d::size_type size_type;
-		typedef texture3d::extent_type extent_type;
-	
-		static void call(texture3d& Output, texture3d const& A, texture3d const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-		
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.z = 0; TexelIndex.z < TexelCount.z; ++TexelIndex.z)
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LevelIndex)));
-				}
-			}
-		}
-	};
+			// Memory shared for copy on write is copied once here rather than by the first band writing it, Output may be A or B
+			Output.data();
 
-	template <typename vec_type>
-	struct compute_transform_cube
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture_cube::size_type size_type;
-		typedef texture_cube::extent_type extent_type;
-			
-		static void call(texture_cube& Output, texture_cube const& A, texture_cube const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.faces() == B.faces());
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-				
-			for(size_type FaceIndex = 0, FaceCount = A.faces(); FaceIndex < FaceCount; ++FaceIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
+			detail::for_each_image_band(detail::split_image_bands(A, 0, A.layers() - 1, 0, A.faces() - 1, 0, A.levels() - 1), [&](image_band const& Band)
 			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, FaceIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, FaceIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, FaceIndex, LevelIndex)));
-				}
-			}
-		}
-	};
-		
-	template <typename vec_type>
-	struct compute_transform_cube_array
-	{
-		typedef typename transform_func<vec_type>::type func_type;
-		typedef texture_cube_array::size_type size_type;
-		typedef texture_cube_array::extent_type extent_type;
-			
-		static void call(texture_cube_array& Output, texture_cube_array const& A, texture_cube_array const& B, func_type Func)
-		{
-			GLI_ASSERT(all(equal(A.extent(), B.extent())));
-			GLI_ASSERT(A.layers() == B.layers());
-			GLI_ASSERT(A.levels() == B.levels());
-			GLI_ASSERT(A.size() == B.size());
-				
-			for(size_type LayerIndex = 0, LayerCount = A.layers(); LayerIndex < LayerCount; ++LayerIndex)
-			for(size_type FaceIndex = 0, FaceCount = A.faces(); FaceIndex < FaceCount; ++FaceIndex)
-			for(size_type LevelIndex = 0, LevelCount = A.levels(); LevelIndex < LevelCount; ++LevelIndex)
-			{
-				extent_type const TexelCount(A.extent(LevelIndex));
-				extent_type TexelIndex(0);
-				
-				for(TexelIndex.y = 0; TexelIndex.y < TexelCount.y; ++TexelIndex.y)
-				for(TexelIndex.x = 0; TexelIndex.x < TexelCount.x; ++TexelIndex.x)
-				{
-					Output.store<vec_type>(TexelIndex, LayerIndex, FaceIndex, LevelIndex, Func(
-						A.load<vec_type>(TexelIndex, LayerIndex, FaceIndex, LevelIndex),
-						B.load<vec_type>(TexelIndex, LayerIndex, FaceIndex, LevelIndex)));
-				}
-			}
+				size_t const Width = static_cast<size_t>(A.extent(Band.Level).x);
+				size_t const First = Width * static_cast<size_t>(Band.Begin);
+				size_t const Count = Width * static_cast<size_t>(Band.End - Band.Begin);
+
+				vec_type* const SpanOut = Output.data<vec_type>(Band.Layer, Band.Face, Band.Level) + First;
+				vec_type const* const SpanA = A.data<vec_type>(Band.Layer, Band.Face, Band.Level) + First;
+				vec_type const* const SpanB = B.data<vec_type>(Band.Layer, Band.Face, Band.Level) + First;
+
+				for(size_t TexelIndex = 0; TexelIndex < Count; ++TexelIndex)
+					SpanOut[TexelIndex] = Func(SpanA[TexelIndex], SpanB[TexelIndex]);
+			});
 		}
 	};
 }//namepsace detail
@@ -216,42 +43,84 @@ namespace detail
 	template <typename vec_type>
 	inline void transform(texture1d& Out, texture1d const& In0, texture1d const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_1d<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture1d& Out, texture1d const& In0, texture1d const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture1d_array& Out, texture1d_array const& In0, texture1d_array const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_1d_array<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture1d_array& Out, texture1d_array const& In0, texture1d_array const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture2d& Out, texture2d const& In0, texture2d const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_2d<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture2d& Out, texture2d const& In0, texture2d const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture2d_array& Out, texture2d_array const& In0, texture2d_array const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_2d_array<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture2d_array& Out, texture2d_array const& In0, texture2d_array const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture3d& Out, texture3d const& In0, texture3d const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_3d<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture3d& Out, texture3d const& In0, texture3d const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture_cube& Out, texture_cube const& In0, texture_cube const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_cube<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture_cube& Out, texture_cube const& In0, texture_cube const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 	
 	template <typename vec_type>
 	inline void transform(texture_cube_array& Out, texture_cube_array const& In0, texture_cube_array const& In1, typename transform_func<vec_type>::type Func)
 	{
-		detail::compute_transform_cube_array<vec_type>::call(Out, In0, In1, Func);
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
+	}
+
+	template <typename vec_type, typename func_type>
+	inline void transform(texture_cube_array& Out, texture_cube_array const& In0, texture_cube_array const& In1, func_type const& Func)
+	{
+		detail::compute_transform<vec_type>::call(Out, In0, In1, Func);
 	}
 }//namespace gli
@@ -0,0 +1,30 @@
+/// @brief Include to decompress textures in S3TC and RGTC formats.
+/// @file gli/decompress.hpp
+
+#pragma once
+
+#include "texture1d.hpp"
+#include "texture1d_array.hpp"
+#include "texture2d.hpp"
+#include "texture2d_array.hpp"
+#include "texture3d.hpp"
+#include "texture_cube.hpp"
+#include "texture_cube_array.hpp"
+#include "execution.hpp"
+
+namespace gli
+{
+	/// Decompress a texture a row of blocks after another. Rows are decompressed in parallel with the default executor.
+	/// Components are converted between color spaces like gli::convert does.
+	///
+	/// @param Texture Source texture: FORMAT_RGB_DXT1_*, FORMAT_RGBA_DXT1_*, FORMAT_RGBA_DXT3_*, FORMAT_RGBA_DXT5_*, FORMAT_R_ATI1N_* or FORMAT_RG_ATI2N_*
+	/// @param Format Destination texture format: FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8 or FORMAT_RGBA32_SFLOAT_PACK32.
+	/// Negative SNORM components are clamped to 0 in 8 bits formats.
+	template <typename texture_type>
+	texture_type decompress(texture_type const& Texture, format Format);
+
+	/// Evaluate whether gli::decompress can decompress textures of a format
+	bool is_decompressible(format Format);
+}//namespace gli
+
+#include "./core/decompress.inl"
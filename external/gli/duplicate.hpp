@@ -11,6 +11,8 @@
 #include "texture3d.hpp"
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
+#include "execution.hpp"
+#include "layout.hpp"
 
 namespace gli
 {
@@ -21,6 +23,11 @@ namespace gli
 	template <typename texType>
 	texture duplicate(texType const& Texture);
 
+	/// Duplicate a texture, deferring the copy of its memory until either the texture or the duplicate is accessed for writing.
+	/// Textures referencing a subset of the faces or levels of their storage are copied right away.
+	template <typename texType>
+	texture duplicate_on_write(texType const& Texture);
+
 	/// Duplicate a texture and create a new texture with a new storage_linear allocation but a different format.
 	/// The format must be a compatible format, a format which block size match the original format. 
 	template <typename texType>
@@ -6,6 +6,7 @@
 #include "format.hpp"
 #include "target.hpp"
 #include <array>
+#include <unordered_map>
 
 namespace gli
 {
@@ -480,7 +481,21 @@ namespace gli
 		gli::format find(d3dfmt FourCC, dxgiFormat Format) const;
 
 	private:
-		std::array<format, FORMAT_COUNT> Translation;
+		// GLI formats by Direct3D 9 format and by DXGI format, built once
+		struct format_map
+		{
+			format_map();
+
+			std::unordered_map<std::uint32_t, gli::format> D3DFormat;
+			std::unordered_map<std::uint32_t, gli::format> DDS;
+			std::unordered_map<std::uint32_t, gli::format> GLI;
+		};
+
+		static format const* get_translation();
+		static format_map const& get_format_map();
+
+		format const* Translation;
+		format_map const* Map;
 	};
 
 	/// Evaluate whether a target and format combinaison is only supported by the DDS container through GLI DDS extension.
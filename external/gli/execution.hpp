@@ -0,0 +1,85 @@
+/// @brief Include to run the image operations of gli on several threads.
+/// @file gli/execution.hpp
+
+#pragma once
+
+#include "texture.hpp"
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gli
+{
+	/// Interface of the executors running the work of gli::convert, gli::generate_mipmaps, gli::transform,
+	/// gli::reduce, gli::flip, gli::flip_in_place and gli::duplicate.
+	/// The work is split in ranges independently of the executor so that results don't depend on it.
+	class executor
+	{
+	public:
+		typedef std::function<void(size_t Begin, size_t End)> task_type;
+
+		virtual ~executor(){}
+
+		/// Call Task over the ranges [Begin, End) of at most Grain items covering [0, Count).
+		/// Ranges may run concurrently and in any order. Returns once all of them are done,
+		/// rethrowing the first exception thrown by Task if any.
+		virtual void parallel_for(size_t Count, size_t Grain, task_type const& Task) = 0;
+	};
+
+	/// Run all the work on the calling thread. The default executor.
+	class executor_sequential : public executor
+	{
+	public:
+		void parallel_for(size_t Count, size_t Grain, task_type const& Task) override;
+	};
+
+	/// Run the work on a pool of threads, the calling thread taking part in it.
+	/// Calls from concurrent threads are serialized, calls from within a Task run on the calling thread.
+	/// Storages allocated by the tasks are under the memory_tag of the calling thread.
+	class executor_thread_pool : public executor
+	{
+	public:
+		/// @param ThreadCount Number of threads running the work including the calling thread, the number of hardware threads if 0
+		explicit executor_thread_pool(size_t ThreadCount = 0);
+		~executor_thread_pool();
+
+		void parallel_for(size_t Count, size_t Grain, task_type const& Task) override;
+
+		/// Return the number of threads running the work including the calling thread.
+		size_t thread_count() const;
+
+		executor_thread_pool(executor_thread_pool const&) = delete;
+		executor_thread_pool& operator=(executor_thread_pool const&) = delete;
+
+	private:
+		void run_worker();
+		void run_ranges(std::unique_lock<std::mutex>& Lock);
+
+		std::vector<std::thread> Threads;
+		std::mutex Mutex;
+		std::condition_variable WorkCondition;
+		std::condition_variable DoneCondition;
+		task_type const* Task;
+		size_t Count;
+		size_t Grain;
+		size_t Next;
+		size_t Done;
+		size_t MemoryTag;
+		std::exception_ptr Exception;
+		bool Busy;
+		bool Stop;
+	};
+
+	/// Return the executor of the image operations.
+	std::shared_ptr<executor> const& default_executor();
+
+	/// Replace the executor of the image operations, the sequential executor if null.
+	/// Not thread safe, call it before running image operations.
+	void set_default_executor(std::shared_ptr<executor> const& Executor);
+}//namespace gli
+
+#include "./core/execution.inl"
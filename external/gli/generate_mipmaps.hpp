@@ -64,6 +64,36 @@ namespace gli
 		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
 		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
 		filter Minification);
+
+	/// Allocate a texture and generate all the mipmaps of the texture averaging blocks of 2x2 texels of the previous level.
+	/// The last row and column of levels of odd sizes average 3 texels of the previous level.
+	/// 8 bits UNORM and 32 bits float formats are averaged directly in memory, 8 bits UNORM rounded to nearest.
+	template <typename texture_type>
+	texture_type generate_mipmaps_box(texture_type const& Texture);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLevel to the MaxLevel included averaging blocks of 2x2 texels.
+	texture2d generate_mipmaps_box(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer and from the BaseLevel to the MaxLevel included levels averaging blocks of 2x2 texels.
+	texture2d_array generate_mipmaps_box(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels averaging blocks of 2x2 texels.
+	texture_cube generate_mipmaps_box(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer, from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels averaging blocks of 2x2 texels.
+	texture_cube_array generate_mipmaps_box(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel);
 }//namespace gli
 
 #include "./core/generate_mipmaps.inl"
@@ -6,6 +6,7 @@
 #include "format.hpp"
 #include "target.hpp"
 #include <array>
+#include <unordered_map>
 
 namespace gli
 {
@@ -347,7 +348,7 @@ namespace gli
 		format translate(gli::format Format, gli::swizzles const& Swizzle) const;
 
 		/// Convert an OpenGL format into a GLI format
-		gli::format find(internal_format InternalFormat, external_format ExternalFormat, type_format Type);
+		gli::format find(internal_format InternalFormat, external_format ExternalFormat, type_format Type) const;
 
 	private:
 		struct format_desc
@@ -358,14 +359,45 @@ namespace gli
 			unsigned int Properties;
 		};
 
-		bool has_swizzle(profile Profile) const
+		struct format_key
+		{
+			internal_format Internal;
+			external_format External;
+			type_format Type;
+
+			bool operator==(format_key const& Key) const
+			{
+				return this->Internal == Key.Internal && this->External == Key.External && this->Type == Key.Type;
+			}
+		};
+
+		struct format_key_hash
+		{
+			std::size_t operator()(format_key const& Key) const
+			{
+				return (static_cast<std::size_t>(Key.Internal) * 31 + static_cast<std::size_t>(Key.External)) * 31 + static_cast<std::size_t>(Key.Type);
+			}
+		};
+
+		// Descriptions of the formats of a profile and GLI formats by OpenGL formats, built once for each profile
+		struct profile_formats
+		{
+			explicit profile_formats(profile Profile);
+
+			std::array<format_desc, FORMAT_COUNT> FormatDesc;
+			std::unordered_map<format_key, gli::format, format_key_hash> Formats;
+		};
+
+		static profile_formats const& get_profile_formats(profile Profile);
+
+		static bool has_swizzle(profile Profile)
 		{
 			return Profile == PROFILE_ES30 || Profile == PROFILE_GL33;
 		}
 
 		gl::swizzles compute_swizzle(format_desc const& FormatDesc, gli::swizzles const& Swizzle) const;
 
-		std::array<format_desc, FORMAT_COUNT> FormatDesc;
+		profile_formats const* Formats;
 		profile Profile;
 	};
 }//namespace gli
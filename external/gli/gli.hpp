@@ -39,6 +39,9 @@ namespace gli
 #include "format.hpp"
 #include "target.hpp"
 #include "levels.hpp"
+#include "allocator.hpp"
+#include "memory_usage.hpp"
+#include "execution.hpp"
 
 #include "image.hpp"
 #include "texture.hpp"
@@ -60,13 +63,18 @@ namespace gli
 
 #include "duplicate.hpp"
 #include "convert.hpp"
+#include "layout.hpp"
+#include "compress.hpp"
+#include "decompress.hpp"
 #include "view.hpp"
 #include "comparison.hpp"
+#include "hash.hpp"
 
 #include "reduce.hpp"
 #include "transform.hpp"
 
 #include "load.hpp"
+#include "load_async.hpp"
 #include "save.hpp"
 
 #include "gl.hpp"
@@ -0,0 +1,27 @@
+/// @brief Include to compute hashes of the content of textures, to build deduplication tables of textures
+/// @file gli/hash.hpp
+
+#pragma once
+
+#include "texture.hpp"
+#include "execution.hpp"
+#include <functional>
+
+namespace gli
+{
+	/// Return a 64 bits hash of a texture, consistent with gli::equal: equal textures have the same hash.
+	/// The hashes of the images are cached with the storage, until its data is accessed for writing,
+	/// so that hashing a texture again or comparing textures already hashed doesn't read their data.
+	uint64 hash(texture const& Texture);
+}//namespace gli
+
+namespace std
+{
+	template <>
+	struct hash<gli::texture>
+	{
+		size_t operator()(gli::texture const& Texture) const;
+	};
+}//namespace std
+
+#include "./core/hash.inl"
@@ -25,7 +25,7 @@ namespace gli
 		image();
 
 		/// Create an image object and allocate an image storoge for it.
-		explicit image(format_type Format, extent_type const& Extent);
+		explicit image(format_type Format, extent_type const& Extent, storage_layout Layout = STORAGE_LAYOUT_LINEAR);
 
 		/// Create an image object by sharing an existing image storage_linear from another image instance.
 		/// This image object is effectively an image view where format can be reinterpreted
@@ -42,6 +42,9 @@ namespace gli
 		/// Return the dimensions of an image instance: width, height and depth.
 		extent_type extent() const;
 
+		/// Return the order of the texels of the image in memory.
+		storage_layout layout() const;
+
 		/// Return the memory size of an image instance storage_linear in bytes.
 		size_type size() const;
 
@@ -76,7 +79,7 @@ namespace gli
 		/// It's an error to call this function if the format is compressed.
 		/// It's an error if TexelCoord values aren't between [0, dimensions].
 		template <typename genType>
-		genType load(extent_type const& TexelCoord);
+		genType load(extent_type const& TexelCoord) const;
 
 		/// Store the texel located at TexelCoord coordinates.
 		/// It's an error to call this function if the format is compressed.
@@ -100,10 +103,10 @@ namespace gli
 		std::shared_ptr<storage_linear> Storage;
 		format_type const Format;
 		size_type const BaseLevel;
-		data_type* Data;
+		size_type const Offset;
 		size_type const Size;
 
-		data_type* compute_data(size_type BaseLayer, size_type BaseFace, size_type BaseLevel);
+		size_type compute_offset(size_type BaseLayer, size_type BaseFace, size_type BaseLevel) const;
 		size_type compute_size(size_type Level) const;
 	};
 }//namespace gli
@@ -0,0 +1,27 @@
+/// @brief Include to change the order of the texels of textures in memory.
+/// @file gli/layout.hpp
+
+#pragma once
+
+#include "texture1d.hpp"
+#include "texture1d_array.hpp"
+#include "texture2d.hpp"
+#include "texture2d_array.hpp"
+#include "texture3d.hpp"
+#include "texture_cube.hpp"
+#include "texture_cube_array.hpp"
+#include "execution.hpp"
+
+namespace gli
+{
+	/// Copy a texture to a new storage with the texels laid out by Layout.
+	/// Tiled textures keep neighbouring texels close in memory, for the samplers and filters accessing texels around a coordinate.
+	/// Files are saved from linear textures, tiled textures being converted when saved.
+	///
+	/// @param Texture Source texture, the format must be uncompressed to be tiled.
+	/// @param Layout Order of the texels of the destination texture.
+	template <typename texture_type>
+	texture_type convert_layout(texture_type const& Texture, storage_layout Layout);
+}//namespace gli
+
+#include "./core/layout.inl"
@@ -0,0 +1,140 @@
+/// @brief Include to load DDS, KTX or KMG textures on worker threads.
+/// @file gli/load_async.hpp
+
+#pragma once
+
+#include "load.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gli
+{
+namespace detail
+{
+	struct load_state;
+
+	struct load_job
+	{
+		std::shared_ptr<load_state> State;
+		std::string Path;
+		std::shared_ptr<std::vector<char> > Data;
+		std::function<texture(texture const&)> Process;
+		std::function<void(texture const&)> Callback;
+		int Priority;
+		size_t Sequence;
+		size_t MemoryTag;
+	};
+
+	struct load_job_order
+	{
+		bool operator()(load_job const& A, load_job const& B) const;
+	};
+}//namespace detail
+
+	/// Handle of a texture queued on a loader.
+	class load_handle
+	{
+	public:
+		/// Construct a handle of no texture, valid() returns false.
+		load_handle();
+
+		/// Whether the handle refers to a queued texture.
+		bool valid() const;
+
+		/// Wait for the texture and return it. Returns an empty texture if the file couldn't be loaded or the load was cancelled.
+		/// Rethrows the exception thrown by the post processing function if any.
+		texture get() const;
+
+		/// Wait for the texture to be loaded, processed or cancelled.
+		void wait() const;
+
+		/// Whether get() returns without waiting.
+		bool ready() const;
+
+		/// Cancel the load if it didn't start yet. Returns whether it was cancelled.
+		bool cancel();
+
+		/// Future of the texture, it can be shared with other threads.
+		std::shared_future<texture> const& future() const;
+
+	private:
+		friend class loader;
+		explicit load_handle(std::shared_ptr<detail::load_state> const& State);
+
+		std::shared_ptr<detail::load_state> State;
+	};
+
+	/// Load textures on a fixed number of worker threads.
+	/// Queued textures are loaded by decreasing priority, in the order they were queued for the same priority.
+	/// Post processing functions, such as gli::flip, gli::convert or gli::generate_mipmaps, run on the worker thread
+	/// after the texture is loaded. Image operations they call use the default executor, see set_default_executor.
+	/// Storages allocated by a job are under the memory_tag of the thread that queued it.
+	class loader
+	{
+	public:
+		/// Function applied to a loaded texture, not called if the texture couldn't be loaded.
+		typedef std::function<texture(texture const& Texture)> process_type;
+
+		/// Function called on the worker thread with the final texture, empty if it couldn't be loaded, before the future is ready.
+		typedef std::function<void(texture const& Texture)> callback_type;
+
+		/// @param ThreadCount Number of worker threads, the number of hardware threads if 0
+		explicit loader(size_t ThreadCount = 0);
+
+		/// Cancel the textures not being loaded yet and wait for the ones being loaded.
+		~loader();
+
+		/// Queue the loading of a file.
+		///
+		/// @param Path Path of the file to load including filename and filename extension
+		/// @param Priority Textures of higher priority are loaded first
+		/// @param Process Optional function applied to the loaded texture
+		/// @param Callback Optional function called with the final texture
+		load_handle load(std::string const& Path, int Priority = 0, process_type const& Process = process_type(), callback_type const& Callback = callback_type());
+
+		/// Queue the loading of a texture in memory. Textures may reference Data instead of copying it.
+		///
+		/// @param Data Data of a texture
+		/// @param Priority Textures of higher priority are loaded first
+		/// @param Process Optional function applied to the loaded texture
+		/// @param Callback Optional function called with the final texture
+		load_handle load(std::vector<char> Data, int Priority = 0, process_type const& Process = process_type(), callback_type const& Callback = callback_type());
+
+		/// Wait until all the queued textures are loaded, processed or cancelled.
+		void wait();
+
+		/// Cancel all the textures not being loaded yet.
+		void cancel();
+
+		/// Return the number of worker threads.
+		size_t thread_count() const;
+
+		loader(loader const&) = delete;
+		loader& operator=(loader const&) = delete;
+
+	private:
+		load_handle push(detail::load_job& Job);
+		void run_worker();
+
+		std::vector<std::thread> Threads;
+		std::mutex Mutex;
+		std::condition_variable WorkCondition;
+		std::condition_variable DoneCondition;
+		std::priority_queue<detail::load_job, std::vector<detail::load_job>, detail::load_job_order> Jobs;
+		size_t Sequence;
+		size_t Running;
+		bool Stop;
+	};
+}//namespace gli
+
+#include "./core/load_async.inl"
@@ -22,6 +22,37 @@ namespace gli
 	/// @param Data Pointer to the beginning of the texture container data to read
 	/// @param Size Size of texture container Data to read
 	texture load_dds(char const* Data, std::size_t Size);
+
+	/// Loads a subset of the layers, faces and levels of a DDS file, reading only the bytes of these images.
+	/// Max values beyond the texture are clamped to it. Returns an empty texture in case of failure or if a range is empty.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_dds(
+		char const* Path,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel);
+
+	/// Loads a subset of the layers, faces and levels of a DDS file, reading only the bytes of these images.
+	/// Max values beyond the texture are clamped to it. Returns an empty texture in case of failure or if a range is empty.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_dds(
+		std::string const& Path,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel);
+
+	/// Loads a subset of the layers, faces and levels of a texture from DDS memory.
+	/// Max values beyond the texture are clamped to it. Returns an empty texture in case of failure or if a range is empty.
+	///
+	/// @param Data Pointer to the beginning of the texture container data to read
+	/// @param Size Size of texture container Data to read
+	texture load_dds(
+		char const* Data, std::size_t Size,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t BaseLevel, size_t MaxLevel);
 }//namespace gli
 
 #include "./core/load_dds.inl"
@@ -0,0 +1,114 @@
+/// @brief Include to account for the memory allocated by texture storages.
+/// @file gli/memory_usage.hpp
+
+#pragma once
+
+#include "type.hpp"
+#include "format.hpp"
+#include "target.hpp"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gli
+{
+	/// Memory allocated by texture storages for a format, a target, a tag or all of them.
+	/// Storages referencing memory they didn't allocate are not accounted for.
+	struct memory_counters
+	{
+		size_t LiveBytes;		///< Bytes currently allocated
+		size_t PeakBytes;		///< Maximum of LiveBytes since the start or the last call to reset_memory_peaks
+		size_t Allocations;		///< Number of allocations since the start
+		size_t Deallocations;	///< Number of deallocations since the start, Allocations - Deallocations are live
+	};
+
+	/// Snapshot of the memory allocated by texture storages. Buckets never used are left out.
+	struct memory_usage
+	{
+		memory_counters Total;
+		std::map<format, memory_counters> Formats;
+		std::map<target, memory_counters> Targets;	///< Storages created outside of a texture are under TARGET_INVALID
+		std::map<std::string, memory_counters> Tags;	///< Storages created outside of any memory_tag are under an empty tag
+	};
+
+	/// Return the memory currently allocated by texture storages, and its peaks.
+	memory_usage current_memory_usage();
+
+	/// Restart the measure of the peaks from the memory currently allocated, for example at the start of a job.
+	void reset_memory_peaks();
+
+	/// Tag the storages allocated on the calling thread for as long as the instance lives, replacing the enclosing tag.
+	/// Storages keep the tag they were created with, including when memory shared for copy on write is copied.
+	class memory_tag
+	{
+	public:
+		explicit memory_tag(char const* Tag);
+		~memory_tag();
+
+		memory_tag(memory_tag const&) = delete;
+		memory_tag& operator=(memory_tag const&) = delete;
+
+	private:
+		size_t const PreviousTag;
+	};
+
+	typedef std::function<void(memory_usage const& Usage)> memory_dump_func;
+
+	/// Call Dump with the memory usage on the first allocation or deallocation of a storage after each Period,
+	/// on the thread allocating or deallocating. Disabled if Dump is empty.
+	/// Dump may run while a storage is destroyed, so exceptions it throws are caught and ignored.
+	void set_memory_dump(memory_dump_func const& Dump, std::chrono::milliseconds Period);
+
+namespace detail
+{
+	// Buckets of an allocation, kept until its deallocation
+	struct memory_key
+	{
+		format Format;
+		target Target;
+		size_t Tag;
+	};
+
+	class memory_accounting
+	{
+	public:
+		memory_accounting();
+
+		void allocated(memory_key const& Key, size_t Size);
+		void deallocated(memory_key const& Key, size_t Size);
+
+		// Return the index of Tag in the tags, adding it if necessary
+		size_t intern(char const* Tag);
+
+		memory_usage usage();
+		void reset_peaks();
+		void set_dump(memory_dump_func const& Dump, std::chrono::milliseconds Period);
+
+	private:
+		memory_usage usage_locked() const;
+		void dump_if_due(std::unique_lock<std::mutex>& Lock);
+
+		std::mutex Mutex;
+		memory_counters Total;
+		std::vector<memory_counters> Formats;
+		std::vector<memory_counters> Targets;
+		std::vector<std::pair<std::string, memory_counters> > Tags;
+
+		memory_dump_func Dump;
+		std::chrono::steady_clock::duration DumpPeriod;
+		std::chrono::steady_clock::time_point DumpTime;
+	};
+
+	memory_accounting& memory_accounting_instance();
+
+	// Index of the tag of the storages allocated on the calling thread
+	size_t& current_memory_tag();
+
+	memory_key make_memory_key(format Format, target Target);
+}//namespace detail
+}//namespace gli
+
+#include "./core/memory_usage.inl"
@@ -10,6 +10,7 @@
 #include "texture3d.hpp"
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
+#include "execution.hpp"
 
 namespace gli
 {
@@ -24,70 +25,133 @@ namespace gli
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture1d const & In0, texture1d const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture1d const & In0, texture1d const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture1d_array const & In0, texture1d_array const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture1d_array const & In0, texture1d_array const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture2d const & In0, texture2d const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture2d const & In0, texture2d const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture2d_array const & In0, texture2d_array const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture2d_array const & In0, texture2d_array const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture3d const & In0, texture3d const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture3d const & In0, texture3d const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture_cube const & In0, texture_cube const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture_cube const & In0, texture_cube const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename vec_type>
 	vec_type reduce(texture_cube_array const & In0, texture_cube_array const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 
+	/// Compute per-texel operations using user defined function objects, called inline on contiguous rows of texels.
+	///
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type for per texel operation.
+	/// @param ReduceFunc Associative function object to reduce texels, texels are reduced by bands of rows then the bands by pairs.
+	template <typename vec_type, typename texel_func_type, typename reduce_func_type>
+	vec_type reduce(texture_cube_array const & In0, texture_cube_array const & In1, texel_func_type const & TexelFunc, reduce_func_type const & ReduceFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param In0 First input texture.
 	/// @param In1 Second input texture.
 	/// @param TexelFunc Pointer to a binary function for per texel operation.
-	/// @param ReduceFunc Pointer to a binary function to reduce texels.
+	/// @param ReduceFunc Pointer to an associative binary function to reduce texels, texels are reduced by bands of rows.
 	template <typename texture_type, typename vec_type>
 	vec_type reduce(texture_type const & In0, texture_type const & In1, typename reduce_func<vec_type>::type TexelFunc, typename reduce_func<vec_type>::type ReduceFunc);
 }//namespace gli
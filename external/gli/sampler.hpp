@@ -42,6 +42,7 @@ namespace gli
 		wrap_type get_func(wrap WrapMode) const;
 
 		wrap_type Wrap;
+		wrap WrapMode;
 		filter Mip;
 		filter Min;
 	};
@@ -7,6 +7,7 @@
 #include "texture_cube.hpp"
 #include "core/mipmaps_compute.hpp"
 #include "core/convert_func.hpp"
+#include "core/filter_batch.hpp"
 
 namespace gli
 {
@@ -44,6 +45,9 @@ namespace gli
 		/// Sample the sampler texture at a specific level
 		texel_type texture_lod(normalized_type const& SampleCoord, size_type Face, level_type Level) const;
 
+		/// Sample the sampler texture of a face at Count coordinates, each at its own level, writing Count texels
+		void texture_lod(normalized_type const* SampleCoords, size_type Face, level_type const* Levels, texel_type* Texels, size_type Count) const;
+
 		/// Generate all the mipmaps of the sampler texture from the texture base level
 		void generate_mipmaps(filter Minification);
 
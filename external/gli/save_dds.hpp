@@ -1,9 +1,11 @@
-/// @brief Include to save DDS textures to files or memory.
+/// @brief Include to save DDS textures to files, file descriptors, functions or memory.
 /// @file gli/save_dds.hpp
 
 #pragma once
 
 #include "texture.hpp"
+#include "layout.hpp"
+#include "./core/file.hpp"
 
 namespace gli
 {
@@ -29,6 +31,30 @@ namespace gli
 	/// @param Memory Storage for the DDS container. The function resizes the containers to fit the necessary storage_linear.
 	/// @return Returns false if the function fails to save the file.
 	bool save_dds(texture const & Texture, std::vector<char> & Memory);
+
+	/// Save a texture storage_linear to a DDS file opened for writing in binary mode, at its current position.
+	/// The images are written from the texture storage without copying them first.
+	///
+	/// @param Texture Source texture to save
+	/// @param File Destination file, left open
+	/// @return Returns false if the function fails to write the file.
+	bool save_dds(texture const & Texture, FILE* File);
+
+	/// Save a texture storage_linear to a DDS file opened for writing, at its current position.
+	/// The images are written from the texture storage, gathered in as few system calls as possible.
+	///
+	/// @param Texture Source texture to save
+	/// @param FileDescriptor Destination file descriptor, left open
+	/// @return Returns false if the function fails to write the file.
+	bool save_dds(texture const & Texture, int FileDescriptor);
+
+	/// Save a texture storage_linear as a DDS container passed piece by piece to a function, in order.
+	/// The pieces reference the texture storage and are only valid during the call.
+	///
+	/// @param Texture Source texture to save
+	/// @param Write Function writing a piece, returning false to stop
+	/// @return Returns false if the function fails to write the file.
+	bool save_dds(texture const & Texture, write_func const& Write);
 }//namespace gli
 
 #include "./core/save_dds.inl"
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "texture.hpp"
+#include "layout.hpp"
 
 namespace gli
 {
@@ -42,6 +42,34 @@ namespace gli
 			size_type Levels,
 			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
 
+		/// Create a texture object and allocate a texture storage for it from Allocator
+		/// @param Allocator Allocator of the storage memory, the default allocator if null.
+		/// @param Init STORAGE_INIT_NONE to skip clearing the storage of a texture about to be entirely overwritten.
+		/// @param Layout STORAGE_LAYOUT_TILED to store the texels of uncompressed formats by tiles, see gli::convert_layout.
+		texture(
+			target_type Target,
+			format_type Format,
+			extent_type const& Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<allocator> const& Allocator,
+			storage_init Init = STORAGE_INIT_ZERO,
+			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA),
+			storage_layout Layout = STORAGE_LAYOUT_LINEAR);
+
+		/// Create a texture object whose storage references existing memory instead of allocating it.
+		/// @param Memory Texel data laid out as storage_linear would lay it out, kept alive by the texture.
+		texture(
+			target_type Target,
+			format_type Format,
+			extent_type const& Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<data_type> const& Memory,
+			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
+
 		/// Create a texture object by sharing an existing texture storage_type from another texture instance.
 		/// This texture object is effectively a texture view where the layer, the face and the level allows identifying
 		/// a specific subset of the texture storage_linear source. 
@@ -65,6 +93,18 @@ namespace gli
 			format_type Format,
 			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
 
+		enum copy_on_write
+		{
+			COPY_ON_WRITE
+		};
+
+		/// Create a texture with a new storage sharing the memory of Texture until either texture, or any texture sharing its storage,
+		/// is accessed for writing. Textures referencing a subset of the faces or levels of their storage are copied right away.
+		/// See gli::duplicate_on_write.
+		texture(
+			texture const& Texture,
+			copy_on_write);
+
 		virtual ~texture(){}
 
 		/// Return whether the texture instance is empty, no storage_type or description have been assigned to the instance.
@@ -78,6 +118,10 @@ namespace gli
 
 		swizzles_type swizzles() const;
 
+		/// Return the order of the texels of the images in memory, shared by all the textures referencing the same storage.
+		/// Accessing the data of tiled textures requires to follow the layout, load and store do.
+		storage_layout layout() const;
+
 		/// Return the base layer of the texture instance, effectively a memory offset in the actual texture storage_type to identify where to start reading the layers. 
 		size_type base_layer() const;
 
@@ -124,7 +168,8 @@ namespace gli
 		template <typename gen_type>
 		size_type size(size_type Level) const;
 
-		/// Return a pointer to the beginning of the texture instance data.
+		/// Return a pointer to the beginning of the texture instance data for writing, discarding the cached hashes of the images.
+		/// Writes through the pointer after the texture is compared or hashed would leave a stale hash, request the pointer again instead.
 		void* data();
 
 		/// Return a pointer of type genType which size must match the texture format block size
@@ -138,7 +183,8 @@ namespace gli
 		template <typename gen_type>
 		gen_type const* data() const;
 
-		/// Return a pointer to the beginning of the texture instance data.
+		/// Return a pointer to the beginning of an image for writing, discarding the cached hashes of the images.
+		/// Writes through the pointer after the texture is compared or hashed would leave a stale hash, request the pointer again instead.
 		void* data(size_type Layer, size_type Face, size_type Level);
 
 		/// Return a pointer to the beginning of the texture instance data.
@@ -152,6 +198,21 @@ namespace gli
 		template <typename gen_type>
 		gen_type const* const data(size_type Layer, size_type Face, size_type Level) const;
 
+		/// Return a 64 bits hash of the content of an image, computed on first use then cached with the storage.
+		/// Accessing the data of the texture, or of any texture sharing its storage, for writing discards the cached hashes.
+		uint64 hash(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Return whether the hash of an image is cached, storing it in Hash if it is.
+		bool cached_hash(size_type Layer, size_type Face, size_type Level, uint64& Hash) const;
+
+		/// Return the number of bytes of an image backed by physical memory. Only allocators like allocator_sparse
+		/// leave parts of the images unbacked, with other allocators it is the size of the image.
+		size_type resident_size(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Release the physical memory of an image, returns false if the allocator of the texture doesn't support it.
+		/// With allocator_sparse, the pages are read back from the backing file or as zeros when next accessed.
+		bool evict(size_type Layer, size_type Face, size_type Level);
+
 		/// Clear the entire texture storage_linear with zeros
 		void clear();
 
@@ -219,44 +280,45 @@ namespace gli
 
 			cache
 			(
-				storage_type& Storage,
+				storage_type const& Storage,
 				format_type Format,
 				size_type BaseLayer, size_type Layers,
 				size_type BaseFace, size_type MaxFace,
 				size_type BaseLevel, size_type MaxLevel
 			)
-				: Faces(MaxFace - BaseFace + 1)
+				: BaseOffset(Storage.base_offset(BaseLayer, BaseFace, BaseLevel))
+				, LayerSize(Storage.layer_size(0, Storage.faces() - 1, 0, Storage.levels() - 1))
+				, FaceSize(Storage.face_size(0, Storage.levels() - 1))
 				, Levels(MaxLevel - BaseLevel + 1)
 			{
 				GLI_ASSERT(static_cast<size_t>(gli::levels(Storage.extent(0))) < this->ImageMemorySize.size());
 
-				this->BaseAddresses.resize(Layers * this->Faces * this->Levels);
-
-				for(size_type Layer = 0; Layer < Layers; ++Layer)
-				for(size_type Face = 0; Face < this->Faces; ++Face)
-				for(size_type Level = 0; Level < this->Levels; ++Level)
-				{
-					size_type const Index = index_cache(Layer, Face, Level);
-					this->BaseAddresses[Index] = Storage.data() + Storage.base_offset(
-						BaseLayer + Layer, BaseFace + Face, BaseLevel + Level);
-				}
-
-				for(size_type Level = 0; Level < this->Levels; ++Level)
+				for(size_type Level = 0, LevelOffset = 0; Level < this->Levels; ++Level)
 				{
 					extent_type const& SrcExtent = Storage.extent(BaseLevel + Level);
 					extent_type const& DstExtent = SrcExtent * block_extent(Format) / Storage.block_extent();
 
 					this->ImageExtent[Level] = glm::max(DstExtent, extent_type(1));
 					this->ImageMemorySize[Level] = Storage.level_size(BaseLevel + Level);
+					this->ImageOffset[Level] = LevelOffset;
+					LevelOffset += this->ImageMemorySize[Level];
 				}
 				
 				this->GlobalMemorySize = Storage.layer_size(BaseFace, MaxFace, BaseLevel, MaxLevel) * Layers;
 			}
 
-			// Base addresses of each images of a texture.
-			data_type* get_base_address(size_type Layer, size_type Face, size_type Level) const
+			// Base addresses of each images of a texture, computed from the layout of the storage so that no memory is allocated per image.
+			// Offsets are cached rather than addresses as the memory of a storage shared for copy on write changes when it is written.
+			data_type* get_base_address(data_type* Memory, size_type Layer, size_type Face, size_type Level) const
 			{
-				return this->BaseAddresses[index_cache(Layer, Face, Level)];
+				GLI_ASSERT(Level < this->Levels);
+				return Memory + this->BaseOffset + Layer * this->LayerSize + Face * this->FaceSize + this->ImageOffset[Level];
+			}
+
+			data_type const* get_base_address(data_type const* Memory, size_type Layer, size_type Face, size_type Level) const
+			{
+				GLI_ASSERT(Level < this->Levels);
+				return Memory + this->BaseOffset + Layer * this->LayerSize + Face * this->FaceSize + this->ImageOffset[Level];
 			}
 
 			// In texels
@@ -278,14 +340,11 @@ namespace gli
 			};
 
 		private:
-			size_type index_cache(size_type Layer, size_type Face, size_type Level) const
-			{
-				return ((Layer * this->Faces) + Face) * this->Levels + Level;
-			}
-
-			size_type Faces;
+			size_type BaseOffset;
+			size_type LayerSize;
+			size_type FaceSize;
 			size_type Levels;
-			std::vector<data_type*> BaseAddresses;
+			std::array<size_type, 16> ImageOffset;
 			std::array<extent_type, 16> ImageExtent;
 			std::array<size_type, 16> ImageMemorySize;
 			size_type GlobalMemorySize;
@@ -10,6 +10,7 @@
 #include "texture3d.hpp"
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
+#include "execution.hpp"
 
 namespace gli
 {
@@ -28,6 +29,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture1d & Out, texture1d const & In0, texture1d const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture1d & Out, texture1d const & In0, texture1d const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -37,6 +47,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture1d_array & Out, texture1d_array const & In0, texture1d_array const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture1d_array & Out, texture1d_array const & In0, texture1d_array const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -46,6 +65,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture2d & Out, texture2d const & In0, texture2d const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture2d & Out, texture2d const & In0, texture2d const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -55,6 +83,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture2d_array & Out, texture2d_array const & In0, texture2d_array const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture2d_array & Out, texture2d_array const & In0, texture2d_array const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -64,6 +101,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture3d & Out, texture3d const & In0, texture3d const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture3d & Out, texture3d const & In0, texture3d const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -73,6 +119,15 @@ namespace gli
 	template <typename vec_type>
 	void transform(texture_cube & Out, texture_cube const & In0, texture_cube const & In1, typename transform_func<vec_type>::type TexelFunc);
 
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture_cube & Out, texture_cube const & In0, texture_cube const & In1, func_type const & TexelFunc);
+
 	/// Compute per-texel operations using a user defined function.
 	///
 	/// @param Out Output texture.
@@ -81,6 +136,15 @@ namespace gli
 	/// @param TexelFunc Pointer to a binary function.
 	template <typename vec_type>
 	void transform(texture_cube_array & Out, texture_cube_array const & In0, texture_cube_array const & In1, typename transform_func<vec_type>::type TexelFunc);
+
+	/// Compute per-texel operations using a user defined function object, called inline on contiguous rows of texels.
+	///
+	/// @param Out Output texture.
+	/// @param In0 First input texture.
+	/// @param In1 Second input texture.
+	/// @param TexelFunc Function object taking two vec_type and returning a vec_type.
+	template <typename vec_type, typename func_type>
+	void transform(texture_cube_array & Out, texture_cube_array const & In0, texture_cube_array const & In1, func_type const & TexelFunc);
 	
 }//namespace gli
 
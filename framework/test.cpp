@@ -288,11 +288,32 @@ glm::vec3 framework::cameraPosition() const
 
 namespace
 {
+	// The heuristics create scratch textures of the same few sizes over and over, entirely overwritten each time
+	std::shared_ptr<gli::allocator> const& scratch_allocator()
+	{
+		static std::shared_ptr<gli::allocator> const Allocator(std::make_shared<gli::allocator_pool>());
+		return Allocator;
+	}
+
+	// Copy the base level of Texture into a texture with room for a complete mipmap chain
+	gli::texture2d mipmaps_base(gli::texture2d const& Texture)
+	{
+		gli::memory_tag const Tag("heuristic mipmaps");
+
+		gli::texture2d Mipmaps(gli::texture(
+			gli::TARGET_2D, Texture.format(), gli::texture::extent_type(Texture.extent(), 1),
+			1, 1, gli::levels(Texture.extent()), scratch_allocator(), gli::STORAGE_INIT_NONE));
+		memcpy(Mipmaps.data(), Texture.data(), Texture.size());
+		return Mipmaps;
+	}
+
 	gli::texture absolute_difference(gli::texture const& A, gli::texture const& B, glm::u8 Scale)
 	{
 		assert(A.format() == gli::FORMAT_RGB8_UNORM_PACK8 && B.format() == gli::FORMAT_RGB8_UNORM_PACK8);
 
-		gli::texture Result(A.target(), A.format(), A.extent(), A.layers(), A.faces(), A.levels());
+		gli::memory_tag const Tag("heuristic difference");
+
+		gli::texture Result(A.target(), A.format(), A.extent(), A.layers(), A.faces(), A.levels(), scratch_allocator(), gli::STORAGE_INIT_NONE);
 		for(std::size_t TexelIndex = 0, TexelCount = A.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
 		{
 			glm::u8vec3 const TexelA = *(A.data<glm::u8vec3>() + TexelIndex);
@@ -437,10 +458,8 @@ namespace
 		{
 			gli::texture2d TextureA(A);
 			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
+			gli::texture2d MipmapsA(mipmaps_base(TextureA));
+			gli::texture2d MipmapsB(mipmaps_base(TextureB));
 			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
 			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
 			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
@@ -469,10 +488,8 @@ namespace
 		{
 			gli::texture2d TextureA(A);
 			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
+			gli::texture2d MipmapsA(mipmaps_base(TextureA));
+			gli::texture2d MipmapsB(mipmaps_base(TextureB));
 			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
 			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
 			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
@@ -532,10 +549,8 @@ namespace
 		{
 			gli::texture2d TextureA(A);
 			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
+			gli::texture2d MipmapsA(mipmaps_base(TextureA));
+			gli::texture2d MipmapsB(mipmaps_base(TextureB));
 			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
 			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
 			gli::texture2d ViewA(gli::view(GeneratedA, 3, 3));
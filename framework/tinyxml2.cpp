@@ -31,6 +31,29 @@ distribution.
 #   include <cstddef>
 #   include <cstdarg>
 #endif
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define TIXML_USE_MMAP
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+#   include <io.h>
+#   define TIXML_WRITE	_write
+#else
+#   include <unistd.h>
+#   define TIXML_WRITE	write
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#   define TIXML_USE_THREADS
+#   include <mutex>
+#   include <thread>
+#endif
 
 #if defined(_MSC_VER) && (_MSC_VER >= 1400 ) && (!defined WINCE)
 	// Microsoft Visual Studio, version 2005 and higher. Not WinCE.
@@ -549,15 +572,49 @@ const char* XMLUtil::GetCharacterRef( const char* p, char* value, int* length )
 }
 
 
+// Writes the decimal representation of 'v' and returns its length, or -1
+// if it doesn't fit, in which case the caller falls back to snprintf for
+// the usual truncation.
+static int FormatDecimal( uint64_t v, bool negative, char* buffer, int bufferSize )
+{
+    char digits[20];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>( '0' + v % 10 );
+        v /= 10;
+    } while ( v );
+
+    const int size = length + ( negative ? 1 : 0 );
+    if ( size >= bufferSize ) {
+        return -1;
+    }
+    char* q = buffer;
+    if ( negative ) {
+        *q++ = '-';
+    }
+    while ( length ) {
+        *q++ = digits[--length];
+    }
+    *q = 0;
+    return size;
+}
+
+
 void XMLUtil::ToStr( int v, char* buffer, int bufferSize )
 {
-    TIXML_SNPRINTF( buffer, bufferSize, "%d", v );
+    const bool negative = v < 0;
+    const uint64_t magnitude = negative ? uint64_t( 0 ) - uint64_t( int64_t( v ) ) : uint64_t( v );
+    if ( FormatDecimal( magnitude, negative, buffer, bufferSize ) < 0 ) {
+        TIXML_SNPRINTF( buffer, bufferSize, "%d", v );
+    }
 }
 
 
 void XMLUtil::ToStr( unsigned v, char* buffer, int bufferSize )
 {
-    TIXML_SNPRINTF( buffer, bufferSize, "%u", v );
+    if ( FormatDecimal( v, false, buffer, bufferSize ) < 0 ) {
+        TIXML_SNPRINTF( buffer, bufferSize, "%u", v );
+    }
 }
 
 
@@ -584,13 +641,61 @@ void XMLUtil::ToStr( double v, char* buffer, int bufferSize )
 
 void XMLUtil::ToStr(int64_t v, char* buffer, int bufferSize)
 {
-	// horrible syntax trick to make the compiler happy about %lld
-	TIXML_SNPRINTF(buffer, bufferSize, "%lld", (long long)v);
+	const bool negative = v < 0;
+	const uint64_t magnitude = negative ? uint64_t(0) - uint64_t(v) : uint64_t(v);
+	if (FormatDecimal(magnitude, negative, buffer, bufferSize) < 0) {
+		// horrible syntax trick to make the compiler happy about %lld
+		TIXML_SNPRINTF(buffer, bufferSize, "%lld", (long long)v);
+	}
+}
+
+
+// Fast path for the common case of a plain decimal integer: an optional
+// sign followed by at most 'maxDigits' digits, which can't overflow.
+// Anything else (leading white space, overflow candidates, no digits at
+// all) returns false, and the caller falls back to sscanf so the result
+// is the same as it always was.
+static bool ParseShortDecimal( const char* str, int maxDigits, bool allowNegative, int64_t* value )
+{
+    TIXMLASSERT( str );
+    TIXMLASSERT( maxDigits > 0 && maxDigits <= 18 );
+
+    bool negative = false;
+    if ( *str == '-' ) {
+        if ( !allowNegative ) {
+            return false;
+        }
+        negative = true;
+        ++str;
+    }
+    else if ( *str == '+' ) {
+        ++str;
+    }
+
+    int64_t v = 0;
+    int digits = 0;
+    while ( *str >= '0' && *str <= '9' ) {
+        if ( ++digits > maxDigits ) {
+            return false;
+        }
+        v = v * 10 + ( *str - '0' );
+        ++str;
+    }
+    if ( digits == 0 ) {
+        return false;
+    }
+    *value = negative ? -v : v;
+    return true;
 }
 
 
 bool XMLUtil::ToInt( const char* str, int* value )
 {
+    int64_t v = 0;
+    if ( ParseShortDecimal( str, 9, true, &v ) ) {
+        *value = (int)v;
+        return true;
+    }
     if ( TIXML_SSCANF( str, "%d", value ) == 1 ) {
         return true;
     }
@@ -599,6 +704,11 @@ bool XMLUtil::ToInt( const char* str, int* value )
 
 bool XMLUtil::ToUnsigned( const char* str, unsigned *value )
 {
+    int64_t v = 0;
+    if ( ParseShortDecimal( str, 9, false, &v ) ) {
+        *value = (unsigned)v;
+        return true;
+    }
     if ( TIXML_SSCANF( str, "%u", value ) == 1 ) {
         return true;
     }
@@ -644,6 +754,9 @@ bool XMLUtil::ToDouble( const char* str, double* value )
 
 bool XMLUtil::ToInt64(const char* str, int64_t* value)
 {
+	if (ParseShortDecimal(str, 18, true, value)) {
+		return true;
+	}
 	long long v = 0;	// horrible syntax trick to make the compiler happy about %lld
 	if (TIXML_SSCANF(str, "%lld", &v) == 1) {
 		*value = (int64_t)v;
@@ -1521,6 +1634,28 @@ const char* XMLElement::Attribute( const char* name, const char* value ) const
     return 0;
 }
 
+int XMLElement::QueryIntAttributes( const char* const* names, int* values, int count ) const
+{
+    TIXMLASSERT( count >= 0 );
+    TIXMLASSERT( count == 0 || ( names && values ) );
+
+    int converted = 0;
+    int matched = 0;
+    for( const XMLAttribute* a = _rootAttribute; a && matched < count; a = a->_next ) {
+        const char* const name = a->Name();
+        for( int i = 0; i < count; ++i ) {
+            if ( XMLUtil::StringEqual( name, names[i] ) ) {
+                ++matched;
+                if ( a->QueryIntValue( &values[i] ) == XML_SUCCESS ) {
+                    ++converted;
+                }
+                break;
+            }
+        }
+    }
+    return converted;
+}
+
 int XMLElement::IntAttribute(const char* name, int defaultValue) const 
 {
 	int i = defaultValue;
@@ -1986,11 +2121,84 @@ const char* XMLDocument::_errorNames[XML_ERROR_COUNT] = {
     "XML_ERROR_MISMATCHED_ELEMENT",
     "XML_ERROR_PARSING",
     "XML_CAN_NOT_CONVERT_TEXT",
-    "XML_NO_TEXT_NODE"
+    "XML_NO_TEXT_NODE",
+    "XML_ERROR_FILE_WRITE_ERROR"
 };
 
 
-XMLDocument::XMLDocument( bool processEntities, Whitespace whitespaceMode ) :
+XMLArena::XMLArena() :
+    _elementPool(),
+    _attributePool(),
+    _textPool(),
+    _commentPool(),
+    _charBuffer( 0 ),
+    _charBufferSize( 0 ),
+    _charBufferInUse( false )
+{
+}
+
+
+XMLArena::~XMLArena()
+{
+    TIXMLASSERT( !_charBufferInUse );
+    delete [] _charBuffer;
+}
+
+
+void XMLArena::Reset()
+{
+    _elementPool.Reset();
+    _attributePool.Reset();
+    _textPool.Reset();
+    _commentPool.Reset();
+}
+
+
+void XMLArena::Clear()
+{
+    TIXMLASSERT( _elementPool.CurrentAllocs() == 0 );
+    TIXMLASSERT( _attributePool.CurrentAllocs() == 0 );
+    TIXMLASSERT( _textPool.CurrentAllocs() == 0 );
+    TIXMLASSERT( _commentPool.CurrentAllocs() == 0 );
+    _elementPool.Clear();
+    _attributePool.Clear();
+    _textPool.Clear();
+    _commentPool.Clear();
+
+    TIXMLASSERT( !_charBufferInUse );
+    delete [] _charBuffer;
+    _charBuffer = 0;
+    _charBufferSize = 0;
+}
+
+
+char* XMLArena::AcquireCharBuffer( size_t size )
+{
+    // Only one document at a time can parse out of the buffer.
+    if ( _charBufferInUse ) {
+        return 0;
+    }
+    if ( size > _charBufferSize ) {
+        delete [] _charBuffer;
+        _charBuffer = new char[size];
+        _charBufferSize = size;
+    }
+    _charBufferInUse = true;
+    return _charBuffer;
+}
+
+
+bool XMLArena::ReleaseCharBuffer( char* buffer )
+{
+    if ( !_charBufferInUse || buffer != _charBuffer ) {
+        return false;
+    }
+    _charBufferInUse = false;
+    return true;
+}
+
+
+XMLDocument::XMLDocument( bool processEntities, Whitespace whitespaceMode, XMLArena* arena ) :
     XMLNode( 0 ),
     _writeBOM( false ),
     _processEntities( processEntities ),
@@ -1999,12 +2207,18 @@ XMLDocument::XMLDocument( bool processEntities, Whitespace whitespaceMode ) :
     _errorStr(),
     _errorLineNum( 0 ),
     _charBuffer( 0 ),
+    _charBufferMapSize( 0 ),
     _parseCurLineNum( 0 ),
+    _parseThreadCount( 1 ),
+    _parseRangeCallback( 0 ),
+    _parseRangeUserData( 0 ),
     _unlinked(),
-    _elementPool(),
-    _attributePool(),
-    _textPool(),
-    _commentPool()
+    _ownArena(),
+    _arena( arena ? arena : &_ownArena ),
+    _elementPool( _arena->_elementPool ),
+    _attributePool( _arena->_attributePool ),
+    _textPool( _arena->_textPool ),
+    _commentPool( _arena->_commentPool )
 {
     // avoid VC++ C4355 warning about 'this' in initializer list (C4355 is off by default in VS2012+)
     _document = this;
@@ -2042,8 +2256,7 @@ void XMLDocument::Clear()
 #endif
     ClearError();
 
-    delete [] _charBuffer;
-    _charBuffer = 0;
+    ReleaseCharBuffer();
 
 #if 0
     _textPool.Trace( "text" );
@@ -2053,7 +2266,8 @@ void XMLDocument::Clear()
 #endif
     
 #ifdef DEBUG
-    if ( !hadError ) {
+    // A shared arena also counts the nodes of the other documents.
+    if ( !hadError && _arena == &_ownArena ) {
         TIXMLASSERT( _elementPool.CurrentAllocs()   == _elementPool.Untracked() );
         TIXMLASSERT( _attributePool.CurrentAllocs() == _attributePool.Untracked() );
         TIXMLASSERT( _textPool.CurrentAllocs()      == _textPool.Untracked() );
@@ -2217,7 +2431,7 @@ XMLError XMLDocument::LoadFile( FILE* fp )
 
     const size_t size = filelength;
     TIXMLASSERT( _charBuffer == 0 );
-    _charBuffer = new char[size+1];
+    _charBuffer = AllocateCharBuffer( size+1 );
     size_t read = fread( _charBuffer, 1, size, fp );
     if ( read != size ) {
         SetError( XML_ERROR_FILE_READ_ERROR, 0, 0 );
@@ -2231,6 +2445,61 @@ XMLError XMLDocument::LoadFile( FILE* fp )
 }
 
 
+XMLError XMLDocument::LoadFileMapped( const char* filename )
+{
+#ifdef TIXML_USE_MMAP
+    Clear();
+    const int fd = filename ? open( filename, O_RDONLY ) : -1;
+    if ( fd == -1 ) {
+        SetError( XML_ERROR_FILE_NOT_FOUND, 0, "filename=%s", filename ? filename : "<null>");
+        return _errorID;
+    }
+
+    struct stat status;
+    if ( fstat( fd, &status ) != 0 || status.st_size < 0 || (unsigned long long)status.st_size >= (size_t)-1 ) {
+        close( fd );
+        SetError( XML_ERROR_FILE_READ_ERROR, 0, 0 );
+        return _errorID;
+    }
+
+    if ( status.st_size == 0 ) {
+        close( fd );
+        SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
+        return _errorID;
+    }
+
+    // The parser relies on a null terminator. Reserve one extra zeroed
+    // byte and map the file over the front of the reservation, so the
+    // terminator exists even when the file ends on a page boundary.
+    // The mapping is private: in-place entity and newline processing
+    // only dirties copy-on-write pages, never the file.
+    const size_t size = (size_t)status.st_size;
+    void* const reserved = mmap( 0, size+1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0 );
+    void* const mapped = reserved == MAP_FAILED ? MAP_FAILED :
+        mmap( reserved, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0 );
+    close( fd );
+    if ( mapped == MAP_FAILED ) {
+        if ( reserved != MAP_FAILED ) {
+            munmap( reserved, size+1 );
+        }
+        SetError( XML_ERROR_FILE_READ_ERROR, 0, 0 );
+        return _errorID;
+    }
+    madvise( mapped, size, MADV_SEQUENTIAL );
+
+    TIXMLASSERT( _charBuffer == 0 );
+    _charBuffer = static_cast<char*>( mapped );
+    _charBufferMapSize = size+1;
+    TIXMLASSERT( _charBuffer[size] == 0 );
+
+    Parse();
+    return _errorID;
+#else
+    return LoadFile( filename );
+#endif
+}
+
+
 XMLError XMLDocument::SaveFile( const char* filename, bool compact )
 {
     FILE* fp = callfopen( filename, "w" );
@@ -2239,7 +2508,9 @@ XMLError XMLDocument::SaveFile( const char* filename, bool compact )
         return _errorID;
     }
     SaveFile(fp, compact);
-    fclose( fp );
+    if ( fclose( fp ) != 0 && _errorID == XML_SUCCESS ) {
+        SetError( XML_ERROR_FILE_WRITE_ERROR, 0, "filename=%s", filename );
+    }
     return _errorID;
 }
 
@@ -2251,6 +2522,9 @@ XMLError XMLDocument::SaveFile( FILE* fp, bool compact )
     ClearError();
     XMLPrinter stream( fp, compact );
     Print( &stream );
+    if ( stream.WriteError() ) {
+        SetError( XML_ERROR_FILE_WRITE_ERROR, 0, 0 );
+    }
     return _errorID;
 }
 
@@ -2267,7 +2541,7 @@ XMLError XMLDocument::Parse( const char* p, size_t len )
         len = strlen( p );
     }
     TIXMLASSERT( _charBuffer == 0 );
-    _charBuffer = new char[ len+1 ];
+    _charBuffer = AllocateCharBuffer( len+1 );
     memcpy( _charBuffer, p, len );
     _charBuffer[len] = 0;
 
@@ -2276,7 +2550,11 @@ XMLError XMLDocument::Parse( const char* p, size_t len )
         // clean up now essentially dangling memory.
         // and the parse fail can put objects in the
         // pools that are dead and inaccessible.
+        // A shared arena keeps them until it is cleared.
         DeleteChildren();
+        if ( _arena != &_ownArena ) {
+            return _errorID;
+        }
         _elementPool.Clear();
         _attributePool.Clear();
         _textPool.Clear();
@@ -2346,6 +2624,36 @@ const char* XMLDocument::ErrorName() const
     return ErrorIDToName(_errorID);
 }
 
+char* XMLDocument::AllocateCharBuffer( size_t size )
+{
+    if ( _arena != &_ownArena ) {
+        char* buffer = _arena->AcquireCharBuffer( size );
+        if ( buffer ) {
+            return buffer;
+        }
+    }
+    return new char[size];
+}
+
+void XMLDocument::ReleaseCharBuffer()
+{
+#ifdef TIXML_USE_MMAP
+    if ( _charBufferMapSize ) {
+        munmap( _charBuffer, _charBufferMapSize );
+        _charBufferMapSize = 0;
+        _charBuffer = 0;
+        return;
+    }
+#endif
+    TIXMLASSERT( _charBufferMapSize == 0 );
+    if ( _arena->ReleaseCharBuffer( _charBuffer ) ) {
+        _charBuffer = 0;
+        return;
+    }
+    delete [] _charBuffer;
+    _charBuffer = 0;
+}
+
 void XMLDocument::Parse()
 {
     TIXMLASSERT( NoChildren() ); // Clear() must have been called previously
@@ -2359,19 +2667,532 @@ void XMLDocument::Parse()
         SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
         return;
     }
+    if ( ( _parseThreadCount != 1 || _parseRangeCallback ) && ParseParallel( p ) ) {
+        return;
+    }
     ParseDeep(p, 0, &_parseCurLineNum );
 }
 
+
+// --------- Parallel parsing ----------- //
+
+// Ranges smaller than this are not worth a thread.
+static const size_t MIN_PARSE_RANGE_SIZE = 64 * 1024;
+
+struct ParseRangeStart {
+    char*   start;
+    int     lineNum;
+};
+
+// Where ParseParallel() splits a document: the root element start tag,
+// the start of each range of root children, and the rest of the
+// document after the root end tag.
+struct ParsePartition {
+    char*   root;
+    int     rootLineNum;
+    DynArray< ParseRangeStart, 16 > ranges;
+    char*   epilogue;
+    int     epilogueLineNum;
+};
+
+// Returns a pointer past 'pattern', or null if it isn't found.
+static char* SkipPast( char* p, const char* pattern, int* lineNum )
+{
+    const size_t length = strlen( pattern );
+    while ( *p ) {
+        if ( *p == *pattern && strncmp( p, pattern, length ) == 0 ) {
+            return p + length;
+        }
+        if ( *p == '\n' ) {
+            ++(*lineNum);
+        }
+        ++p;
+    }
+    return 0;
+}
+
+// Skips a start tag, from its name up to and including the closing '>',
+// stepping over quoted attribute values. Returns null if it isn't closed.
+static char* SkipStartTag( char* p, int* lineNum, bool* selfClosed )
+{
+    char quote = 0;
+    for ( ; *p; ++p ) {
+        if ( *p == '\n' ) {
+            ++(*lineNum);
+        }
+        if ( quote ) {
+            if ( *p == quote ) {
+                quote = 0;
+            }
+        }
+        else if ( *p == '\"' || *p == '\'' ) {
+            quote = *p;
+        }
+        else if ( *p == '>' ) {
+            *selfClosed = *(p-1) == '/';
+            return p + 1;
+        }
+    }
+    return 0;
+}
+
+// Read-only scan of the document for top level element boundaries among
+// the children of the root element, splitting them into at most
+// 'rangeCount' ranges of similar size. A range may only start where the
+// parser would discard the white space in front of it, so that one byte
+// of that white space can be overwritten with a terminator.
+// Returns false for anything unusual; the serial parser handles those.
+static bool PartitionDocument( char* p, int lineNum, int rangeCount, ParsePartition* partition )
+{
+    // Prolog: declarations first, then comments and DTD.
+    bool declarationAllowed = true;
+    for ( ;; ) {
+        p = XMLUtil::SkipWhiteSpace( p, &lineNum );
+        if ( *p != '<' ) {
+            return false;
+        }
+        if ( XMLUtil::StringEqual( p, "<?", 2 ) ) {
+            if ( !declarationAllowed ) {
+                return false;
+            }
+            p = SkipPast( p + 2, "?>", &lineNum );
+        }
+        else if ( XMLUtil::StringEqual( p, "<!--", 4 ) ) {
+            declarationAllowed = false;
+            p = SkipPast( p + 4, "-->", &lineNum );
+        }
+        else if ( XMLUtil::StringEqual( p, "<!", 2 ) ) {
+            declarationAllowed = false;
+            for ( ++p; *p && *p != '>'; ++p ) {
+                if ( *p == '[' ) {
+                    return false;
+                }
+                if ( *p == '\n' ) {
+                    ++lineNum;
+                }
+            }
+            p = *p ? p + 1 : 0;
+        }
+        else {
+            break;
+        }
+        if ( !p ) {
+            return false;
+        }
+    }
+
+    // Root element start tag.
+    if ( !XMLUtil::IsNameStartChar( static_cast<unsigned char>( *(p+1) ) ) ) {
+        return false;
+    }
+    partition->root = p;
+    partition->rootLineNum = lineNum;
+    const char* const rootName = p + 1;
+    int rootNameLength = 1;
+    while ( XMLUtil::IsNameChar( static_cast<unsigned char>( rootName[rootNameLength] ) ) ) {
+        ++rootNameLength;
+    }
+    bool selfClosed = false;
+    p = SkipStartTag( p + 1, &lineNum, &selfClosed );
+    if ( !p || selfClosed ) {
+        return false;
+    }
+
+    // Root element content.
+    const size_t rangeSize = strlen( p ) / rangeCount;
+    ParseRangeStart first = { p, lineNum };
+    partition->ranges.Push( first );
+    int depth = 0;
+    bool textSinceMarkup = false;
+    while ( *p ) {
+        if ( *p != '<' ) {
+            if ( *p == '\n' ) {
+                ++lineNum;
+            }
+            else if ( !XMLUtil::IsWhiteSpace( *p ) ) {
+                textSinceMarkup = true;
+            }
+            ++p;
+            continue;
+        }
+
+        if ( XMLUtil::StringEqual( p, "<!--", 4 ) ) {
+            p = SkipPast( p + 4, "-->", &lineNum );
+        }
+        else if ( XMLUtil::StringEqual( p, "<![CDATA[", 9 ) ) {
+            p = SkipPast( p + 9, "]]>", &lineNum );
+        }
+        else if ( XMLUtil::StringEqual( p, "<?", 2 ) ) {
+            return false;
+        }
+        else if ( XMLUtil::StringEqual( p, "<!", 2 ) ) {
+            for ( ++p; *p && *p != '>'; ++p ) {
+                if ( *p == '[' ) {
+                    return false;
+                }
+                if ( *p == '\n' ) {
+                    ++lineNum;
+                }
+            }
+            p = *p ? p + 1 : 0;
+        }
+        else if ( *(p+1) == '/' ) {
+            if ( depth == 0 ) {
+                // Root element end tag.
+                p += 2;
+                if ( !XMLUtil::StringEqual( p, rootName, rootNameLength ) || XMLUtil::IsNameChar( static_cast<unsigned char>( p[rootNameLength] ) ) ) {
+                    return false;
+                }
+                p = XMLUtil::SkipWhiteSpace( p + rootNameLength, &lineNum );
+                if ( *p != '>' ) {
+                    return false;
+                }
+                partition->epilogue = p + 1;
+                partition->epilogueLineNum = lineNum;
+                return true;
+            }
+            --depth;
+            p = SkipPast( p + 2, ">", &lineNum );
+        }
+        else {
+            const ParseRangeStart& current = partition->ranges.PeekTop();
+            if ( depth == 0 && !textSinceMarkup && XMLUtil::IsWhiteSpace( *(p-1) )
+                    && partition->ranges.Size() < rangeCount
+                    && static_cast<size_t>( p - current.start ) >= rangeSize ) {
+                ParseRangeStart next = { p, lineNum };
+                partition->ranges.Push( next );
+            }
+            p = SkipStartTag( p + 1, &lineNum, &selfClosed );
+            if ( p && !selfClosed ) {
+                ++depth;
+            }
+        }
+        if ( !p ) {
+            return false;
+        }
+        textSinceMarkup = false;
+    }
+    return false;
+}
+
+
+void XMLDocument::Retarget( XMLNode* node, const XMLDocument& from )
+{
+    TIXMLASSERT( node->_document == &from );
+    node->_document = this;
+    if ( node->_memPool == &from._elementPool ) {
+        node->_memPool = &_elementPool;
+    }
+    else if ( node->_memPool == &from._textPool ) {
+        node->_memPool = &_textPool;
+    }
+    else {
+        TIXMLASSERT( node->_memPool == &from._commentPool );
+        node->_memPool = &_commentPool;
+    }
+
+    XMLElement* element = node->ToElement();
+    if ( element ) {
+        for( XMLAttribute* a = element->_rootAttribute; a; a = a->_next ) {
+            TIXMLASSERT( a->_memPool == &from._attributePool );
+            a->_memPool = &_attributePool;
+        }
+    }
+    for( XMLNode* child = node->_firstChild; child; child = child->_next ) {
+        Retarget( child, from );
+    }
+}
+
+
+void XMLDocument::ParseRange( char* p, int lineNum, XMLDocument* owner, int rangeIndex )
+{
+    _parseCurLineNum = lineNum;
+    ParseDeep( p, 0, &_parseCurLineNum );
+    if ( Error() ) {
+        return;
+    }
+
+    if ( owner->_parseRangeCallback ) {
+        owner->_parseRangeCallback( this, rangeIndex, owner->_parseRangeUserData );
+    }
+    else {
+        // Only rewrites pointers into the owner, so it can run concurrently.
+        for( XMLNode* node = _firstChild; node; node = node->_next ) {
+            owner->Retarget( node, *this );
+        }
+    }
+}
+
+
+// Free items of a pool of the owner document of a parallel parse, handed to
+// the pools of the ranges.
+template< int ITEM_SIZE >
+class RangeReserve
+{
+public:
+    RangeReserve( MemPoolT< ITEM_SIZE >& pool ) : _pool( pool ), _free( pool.FreeCount() ) {}
+
+    // Give 'range' its share of the free items up front and let it refill
+    // from the remaining ones.
+    void Lend( MemPoolT< ITEM_SIZE >& range, double share ) {
+        _pool.Lend( range, static_cast<int>( _free * share * 3 / 4 ) );
+        range.SetRefill( Refill, this );
+    }
+
+private:
+    static bool Refill( MemPoolT< ITEM_SIZE >& range, void* context ) {
+        RangeReserve* reserve = static_cast<RangeReserve*>( context );
+#ifdef TIXML_USE_THREADS
+        std::lock_guard<std::mutex> lock( reserve->_mutex );
+#endif
+        return reserve->_pool.Lend( range, MemPoolT< ITEM_SIZE >::ITEMS_PER_BLOCK ) > 0;
+    }
+
+    MemPoolT< ITEM_SIZE >& _pool;
+    const int _free;
+#ifdef TIXML_USE_THREADS
+    std::mutex _mutex;
+#endif
+};
+
+bool XMLDocument::ParseParallel( char* p )
+{
+    int threadCount = _parseThreadCount;
+#ifdef TIXML_USE_THREADS
+    if ( threadCount <= 0 ) {
+        threadCount = static_cast<int>( std::thread::hardware_concurrency() );
+    }
+#endif
+    if ( threadCount <= 0 ) {
+        threadCount = 1;
+    }
+
+    const size_t maxRangeCount = strlen( p ) / MIN_PARSE_RANGE_SIZE;
+    const int rangeCount = static_cast<size_t>( threadCount ) < maxRangeCount ? threadCount : ( maxRangeCount > 1 ? static_cast<int>( maxRangeCount ) : 1 );
+    if ( rangeCount < 2 && !_parseRangeCallback ) {
+        return false;
+    }
+
+    ParsePartition partition;
+    if ( !PartitionDocument( p, _parseCurLineNum, rangeCount, &partition ) ) {
+        return false;
+    }
+    if ( partition.ranges.Size() < 2 && !_parseRangeCallback ) {
+        return false;
+    }
+
+    // Prolog: everything in front of the root element.
+    for ( ;; ) {
+        p = XMLUtil::SkipWhiteSpace( p, &_parseCurLineNum );
+        if ( p >= partition.root ) {
+            break;
+        }
+        XMLNode* node = 0;
+        p = Identify( p, &node );
+        TIXMLASSERT( node );
+        const int initialLineNum = node->_parseLineNum;
+        p = node->ParseDeep( p, 0, &_parseCurLineNum );
+        if ( !p ) {
+            DeleteNode( node );
+            if ( !Error() ) {
+                SetError( XML_ERROR_PARSING, initialLineNum, 0 );
+            }
+            return true;
+        }
+        InsertEndChild( node );
+    }
+    TIXMLASSERT( p == partition.root );
+    TIXMLASSERT( _parseCurLineNum == partition.rootLineNum );
+
+    // Root element start tag. Its end tag was checked by PartitionDocument().
+    XMLElement* root = CreateUnlinkedNode<XMLElement>( _elementPool );
+    root->_parseLineNum = _parseCurLineNum;
+    p = root->_value.ParseName( p + 1 );
+    p = p ? root->ParseAttributes( p, &_parseCurLineNum ) : 0;
+    if ( !p ) {
+        const int initialLineNum = root->_parseLineNum;
+        DeleteNode( root );
+        if ( !Error() ) {
+            SetError( XML_ERROR_PARSING, initialLineNum, 0 );
+        }
+        return true;
+    }
+    TIXMLASSERT( p == partition.ranges[0].start );
+    InsertEndChild( root );
+
+    // Terminate each range in the white space in front of the next one.
+    // The last range stops at the root element end tag.
+    const int count = partition.ranges.Size();
+    for( int i = 1; i < count; ++i ) {
+        TIXMLASSERT( XMLUtil::IsWhiteSpace( *(partition.ranges[i].start - 1) ) );
+        *(partition.ranges[i].start - 1) = 0;
+    }
+
+    // The ranges allocate from the free items of the pools, so that a warm
+    // arena is reused instead of growing on every parse. Each range gets most
+    // of its share up front, in proportion to its size, and draws from the
+    // rest when it runs out. Adopt() gives them back below, with the blocks
+    // the ranges had to allocate once the free items are exhausted.
+    XMLDocument** ranges = new XMLDocument*[count];
+    RangeReserve< sizeof(XMLElement) > elementReserve( _elementPool );
+    RangeReserve< sizeof(XMLAttribute) > attributeReserve( _attributePool );
+    RangeReserve< sizeof(XMLText) > textReserve( _textPool );
+    RangeReserve< sizeof(XMLComment) > commentReserve( _commentPool );
+    const double totalSize = static_cast<double>( partition.epilogue - partition.ranges[0].start );
+    for( int i = 0; i < count; ++i ) {
+        const char* end = i + 1 < count ? partition.ranges[i + 1].start : partition.epilogue;
+        const double share = ( end - partition.ranges[i].start ) / totalSize;
+        ranges[i] = new XMLDocument( _processEntities, _whitespaceMode );
+        elementReserve.Lend( ranges[i]->_elementPool, share );
+        attributeReserve.Lend( ranges[i]->_attributePool, share );
+        textReserve.Lend( ranges[i]->_textPool, share );
+        commentReserve.Lend( ranges[i]->_commentPool, share );
+    }
+#ifdef TIXML_USE_THREADS
+    std::thread* threads = new std::thread[count];
+    for( int i = 1; i < count; ++i ) {
+        threads[i] = std::thread( &XMLDocument::ParseRange, ranges[i], partition.ranges[i].start, partition.ranges[i].lineNum, this, i );
+    }
+    ranges[0]->ParseRange( partition.ranges[0].start, partition.ranges[0].lineNum, this, 0 );
+    for( int i = 1; i < count; ++i ) {
+        threads[i].join();
+    }
+    delete [] threads;
+#else
+    for( int i = 0; i < count; ++i ) {
+        ranges[i]->ParseRange( partition.ranges[i].start, partition.ranges[i].lineNum, this, i );
+    }
+#endif
+
+    // Report the first error in document order, or link the ranges
+    // under the root element in document order.
+    for( int i = 0; i < count && !Error(); ++i ) {
+        XMLDocument* range = ranges[i];
+        if ( range->Error() ) {
+            SetError( range->_errorID, range->_errorLineNum, 0 );
+            if ( !range->_errorStr.Empty() ) {
+                _errorStr.SetStr( range->ErrorStr() );
+            }
+        }
+    }
+    if ( !Error() && !_parseRangeCallback ) {
+        for( int i = 0; i < count; ++i ) {
+            XMLDocument* range = ranges[i];
+            if ( !range->_firstChild ) {
+                continue;
+            }
+            TIXMLASSERT( range->_unlinked.Empty() );
+            for( XMLNode* node = range->_firstChild; node; node = node->_next ) {
+                node->_parent = root;
+            }
+            if ( root->_lastChild ) {
+                root->_lastChild->_next = range->_firstChild;
+                range->_firstChild->_prev = root->_lastChild;
+            }
+            else {
+                root->_firstChild = range->_firstChild;
+            }
+            root->_lastChild = range->_lastChild;
+            range->_firstChild = range->_lastChild = 0;
+        }
+    }
+    // Nodes left in the ranges, on error or after the callback, are freed
+    // into the range pools before the pools go back to the owner. Ranges
+    // that parsed cleanly already handed their nodes to the owner pools.
+    for( int i = 0; i < count; ++i ) {
+        XMLDocument* range = ranges[i];
+        for( XMLNode* node = range->_firstChild; node; node = node->_next ) {
+            if ( node->_document != range ) {
+                range->Retarget( node, *this );
+            }
+        }
+        range->DeleteChildren();
+        while( range->_unlinked.Size() ) {
+            range->DeleteNode( range->_unlinked[0] );
+        }
+        _elementPool.Adopt( range->_elementPool );
+        _attributePool.Adopt( range->_attributePool );
+        _textPool.Adopt( range->_textPool );
+        _commentPool.Adopt( range->_commentPool );
+        delete range;
+    }
+    delete [] ranges;
+
+    if ( Error() ) {
+        return true;
+    }
+
+    // Epilogue: everything after the root element.
+    _parseCurLineNum = partition.epilogueLineNum;
+    ParseDeep( partition.epilogue, 0, &_parseCurLineNum );
+    return true;
+}
+
 XMLPrinter::XMLPrinter( FILE* file, bool compact, int depth ) :
     _elementJustOpened( false ),
     _stack(),
     _firstElement( true ),
+    _writeError( false ),
     _fp( file ),
+    _fd( -1 ),
+    _streamBuffer( 0 ),
+    _streamBufferSize( 0 ),
+    _streamBufferUsed( 0 ),
+    _depth( depth ),
+    _textDepth( -1 ),
+    _processEntities( true ),
+    _compactMode( compact ),
+    _buffer()
+{
+    Init();
+}
+
+
+XMLPrinter::XMLPrinter( char* buffer, int bufferSize, FILE* file, bool compact, int depth ) :
+    _elementJustOpened( false ),
+    _stack(),
+    _firstElement( true ),
+    _writeError( false ),
+    _fp( file ),
+    _fd( -1 ),
+    _streamBuffer( buffer ),
+    _streamBufferSize( bufferSize ),
+    _streamBufferUsed( 0 ),
+    _depth( depth ),
+    _textDepth( -1 ),
+    _processEntities( true ),
+    _compactMode( compact ),
+    _buffer()
+{
+    TIXMLASSERT( file );
+    TIXMLASSERT( buffer && bufferSize > 0 );
+    Init();
+}
+
+
+XMLPrinter::XMLPrinter( char* buffer, int bufferSize, int fd, bool compact, int depth ) :
+    _elementJustOpened( false ),
+    _stack(),
+    _firstElement( true ),
+    _writeError( false ),
+    _fp( 0 ),
+    _fd( fd ),
+    _streamBuffer( buffer ),
+    _streamBufferSize( bufferSize ),
+    _streamBufferUsed( 0 ),
     _depth( depth ),
     _textDepth( -1 ),
     _processEntities( true ),
     _compactMode( compact ),
     _buffer()
+{
+    TIXMLASSERT( fd >= 0 );
+    TIXMLASSERT( buffer && bufferSize > 0 );
+    Init();
+}
+
+
+void XMLPrinter::Init()
 {
     for( int i=0; i<ENTITY_RANGE; ++i ) {
         _entityFlag[i] = false;
@@ -2390,12 +3211,75 @@ XMLPrinter::XMLPrinter( FILE* file, bool compact, int depth ) :
 }
 
 
+void XMLPrinter::Flush()
+{
+    if ( _streamBufferUsed ) {
+        const int used = _streamBufferUsed;
+        _streamBufferUsed = 0;
+        WriteStream( _streamBuffer, used );
+    }
+}
+
+
+bool XMLPrinter::WriteError() const
+{
+    return _writeError || ( _fp && ferror( _fp ) );
+}
+
+
+void XMLPrinter::WriteStream( const char* data, size_t size )
+{
+    if ( _writeError ) {
+        return;
+    }
+    if ( _fp ) {
+        if ( fwrite( data, sizeof(char), size, _fp ) != size ) {
+            _writeError = true;
+        }
+        return;
+    }
+    TIXMLASSERT( _fd >= 0 );
+    while ( size ) {
+        const int chunk = size < (size_t)INT_MAX ? (int)size : INT_MAX;
+        const int written = (int)TIXML_WRITE( _fd, data, chunk );
+        if ( written < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( written <= 0 ) {
+            _writeError = true;
+            return;
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+
 void XMLPrinter::Print( const char* format, ... )
 {
     va_list     va;
     va_start( va, format );
 
-    if ( _fp ) {
+    if ( _streamBuffer ) {
+        const int len = TIXML_VSCPRINTF( format, va );
+        va_end( va );
+        TIXMLASSERT( len >= 0 );
+        va_start( va, format );
+        if ( _streamBufferUsed + len >= _streamBufferSize ) {
+            Flush();
+        }
+        if ( len < _streamBufferSize ) {
+            TIXML_VSNPRINTF( _streamBuffer + _streamBufferUsed, _streamBufferSize - _streamBufferUsed, format, va );
+            _streamBufferUsed += len;
+        }
+        else {
+            char* text = new char[len+1];
+            TIXML_VSNPRINTF( text, len+1, format, va );
+            WriteStream( text, len );
+            delete [] text;
+        }
+    }
+    else if ( _fp ) {
         vfprintf( _fp, format, va );
     }
     else {
@@ -2414,7 +3298,18 @@ void XMLPrinter::Print( const char* format, ... )
 
 void XMLPrinter::Write( const char* data, size_t size )
 {
-    if ( _fp ) {
+    if ( _streamBuffer ) {
+        if ( size > (size_t)( _streamBufferSize - _streamBufferUsed ) ) {
+            Flush();
+            if ( size >= (size_t)_streamBufferSize ) {
+                WriteStream( data, size );
+                return;
+            }
+        }
+        memcpy( _streamBuffer + _streamBufferUsed, data, size );
+        _streamBufferUsed += (int)size;
+    }
+    else if ( _fp ) {
         fwrite ( data , sizeof(char), size, _fp);
     }
     else {
@@ -2427,7 +3322,13 @@ void XMLPrinter::Write( const char* data, size_t size )
 
 void XMLPrinter::Putc( char ch )
 {
-    if ( _fp ) {
+    if ( _streamBuffer ) {
+        if ( _streamBufferUsed == _streamBufferSize ) {
+            Flush();
+        }
+        _streamBuffer[_streamBufferUsed++] = ch;
+    }
+    else if ( _fp ) {
         fputc ( ch, _fp);
     }
     else {
@@ -2543,11 +3444,22 @@ void XMLPrinter::PushAttribute( const char* name, const char* value )
 }
 
 
+void XMLPrinter::PushNumericAttribute( const char* name, const char* value )
+{
+    TIXMLASSERT( _elementJustOpened );
+    Putc ( ' ' );
+    Write( name );
+    Write( "=\"" );
+    Write( value );
+    Putc ( '\"' );
+}
+
+
 void XMLPrinter::PushAttribute( const char* name, int v )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( v, buf, BUF_SIZE );
-    PushAttribute( name, buf );
+    PushNumericAttribute( name, buf );
 }
 
 
@@ -2555,7 +3467,7 @@ void XMLPrinter::PushAttribute( const char* name, unsigned v )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( v, buf, BUF_SIZE );
-    PushAttribute( name, buf );
+    PushNumericAttribute( name, buf );
 }
 
 
@@ -2563,7 +3475,7 @@ void XMLPrinter::PushAttribute(const char* name, int64_t v)
 {
 	char buf[BUF_SIZE];
 	XMLUtil::ToStr(v, buf, BUF_SIZE);
-	PushAttribute(name, buf);
+	PushNumericAttribute(name, buf);
 }
 
 
@@ -2579,7 +3491,7 @@ void XMLPrinter::PushAttribute( const char* name, double v )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( v, buf, BUF_SIZE );
-    PushAttribute( name, buf );
+    PushNumericAttribute( name, buf );
 }
 
 
@@ -2636,18 +3548,26 @@ void XMLPrinter::PushText( const char* text, bool cdata )
     }
 }
 
+void XMLPrinter::PushNumericText( const char* value )
+{
+    _textDepth = _depth-1;
+
+    SealElementIfJustOpened();
+    Write( value );
+}
+
 void XMLPrinter::PushText( int64_t value )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( value, buf, BUF_SIZE );
-    PushText( buf, false );
+    PushNumericText( buf );
 }
 
 void XMLPrinter::PushText( int value )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( value, buf, BUF_SIZE );
-    PushText( buf, false );
+    PushNumericText( buf );
 }
 
 
@@ -2655,7 +3575,7 @@ void XMLPrinter::PushText( unsigned value )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( value, buf, BUF_SIZE );
-    PushText( buf, false );
+    PushNumericText( buf );
 }
 
 
@@ -2671,7 +3591,7 @@ void XMLPrinter::PushText( float value )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( value, buf, BUF_SIZE );
-    PushText( buf, false );
+    PushNumericText( buf );
 }
 
 
@@ -2679,7 +3599,7 @@ void XMLPrinter::PushText( double value )
 {
     char buf[BUF_SIZE];
     XMLUtil::ToStr( value, buf, BUF_SIZE );
-    PushText( buf, false );
+    PushNumericText( buf );
 }
 
 
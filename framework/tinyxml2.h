@@ -309,6 +309,19 @@ private:
 };
 
 
+/**
+	Usage counters of one of the memory pools of an XMLArena.
+*/
+struct XMLPoolStats
+{
+    int itemSize;		// bytes per item
+    int currentAllocs;	// items in use
+    int highWater;		// most items in use at once
+    int totalAllocs;	// items handed out since the pool was last cleared
+    int blocks;			// blocks held by the pool, in use or not
+};
+
+
 /*
 	Parent virtual class of a pool for fast allocation
 	and deallocation of objects.
@@ -334,7 +347,11 @@ template< int ITEM_SIZE >
 class MemPoolT : public MemPool
 {
 public:
-    MemPoolT() : _blockPtrs(), _root(0), _currentAllocs(0), _nAllocs(0), _maxAllocs(0), _nUntracked(0)	{}
+    // Called when the free list is empty, before allocating a new block. Returns
+    // true once it has put items on the free list of 'pool'.
+    typedef bool (*RefillFunc)( MemPoolT& pool, void* context );
+
+    MemPoolT() : _blockPtrs(), _root(0), _currentAllocs(0), _nAllocs(0), _maxAllocs(0), _nUntracked(0), _refill(0), _refillContext(0)	{}
     ~MemPoolT() {
         Clear();
     }
@@ -352,6 +369,77 @@ public:
         _nUntracked = 0;
     }
 
+    // Take ownership of all of 'other's blocks, with the items still in use
+    // as well as the free ones. 'other' is left empty.
+    void Adopt( MemPoolT& other ) {
+        TIXMLASSERT( &other != this );
+        while( !other._blockPtrs.Empty() ) {
+            _blockPtrs.Push( other._blockPtrs.Pop() );
+        }
+        if ( other._root ) {
+            Item* last = other._root;
+            while( last->next ) {
+                last = last->next;
+            }
+            last->next = _root;
+            _root = other._root;
+        }
+        _currentAllocs += other._currentAllocs;
+        _nAllocs += other._nAllocs;
+        _nUntracked += other._nUntracked;
+        // The peaks of the two pools were not reached at the same time.
+        if ( _currentAllocs > _maxAllocs ) {
+            _maxAllocs = _currentAllocs;
+        }
+
+        other._root = 0;
+        other._currentAllocs = 0;
+        other._nAllocs = 0;
+        other._maxAllocs = 0;
+        other._nUntracked = 0;
+    }
+
+    // Move up to 'count' items of the free list to the free list of 'other',
+    // which hands them out until Adopt() gives them back. The blocks stay here.
+    // Returns the number of items moved.
+    int Lend( MemPoolT& other, int count ) {
+        TIXMLASSERT( &other != this );
+        int lent = 0;
+        for( ; lent < count && _root; ++lent ) {
+            Item* item = _root;
+            _root = item->next;
+            item->next = other._root;
+            other._root = item;
+        }
+        return lent;
+    }
+
+    void SetRefill( RefillFunc refill, void* context ) {
+        _refill = refill;
+        _refillContext = context;
+    }
+
+    // Number of items on the free list.
+    int FreeCount() const {
+        return _blockPtrs.Size() * ITEMS_PER_BLOCK - _currentAllocs;
+    }
+
+    // Put every item back on the free list, keeping the blocks for reuse.
+    // Only valid once all the items have been freed.
+    void Reset() {
+        TIXMLASSERT( _currentAllocs == 0 );
+        _root = 0;
+        for( int b = _blockPtrs.Size() - 1; b >= 0; --b ) {
+            Item* blockItems = _blockPtrs[b]->items;
+            for( int i = ITEMS_PER_BLOCK - 1; i >= 0; --i ) {
+                blockItems[i].next = _root;
+                _root = &blockItems[i];
+            }
+        }
+        _currentAllocs = 0;
+        _nUntracked = 0;
+    }
+
     virtual int ItemSize() const	{
         return ITEM_SIZE;
     }
@@ -359,7 +447,20 @@ public:
         return _currentAllocs;
     }
 
+    XMLPoolStats Stats() const {
+        XMLPoolStats stats;
+        stats.itemSize = ITEM_SIZE;
+        stats.currentAllocs = _currentAllocs;
+        stats.highWater = _maxAllocs;
+        stats.totalAllocs = _nAllocs;
+        stats.blocks = _blockPtrs.Size();
+        return stats;
+    }
+
     virtual void* Alloc() {
+        if ( !_root && _refill ) {
+            _refill( *this, _refillContext );
+        }
         if ( !_root ) {
             // Need a new block.
             Block* block = new Block();
@@ -442,6 +543,9 @@ private:
     int _nAllocs;
     int _maxAllocs;
     int _nUntracked;
+
+    RefillFunc _refill;
+    void* _refillContext;
 };
 
 
@@ -528,6 +632,7 @@ enum XMLError {
     XML_ERROR_PARSING,
     XML_CAN_NOT_CONVERT_TEXT,
     XML_NO_TEXT_NODE,
+    XML_ERROR_FILE_WRITE_ERROR,
 
 	XML_ERROR_COUNT
 };
@@ -1122,6 +1227,7 @@ private:
 class TINYXML2_LIB XMLAttribute
 {
     friend class XMLElement;
+    friend class XMLDocument;
 public:
     /// The name of the attribute.
     const char* Name() const;
@@ -1361,6 +1467,22 @@ public:
         return a->QueryFloatValue( value );
     }
 
+    /**
+    	Given an array of 'count' attribute names, QueryIntAttributes()
+    	looks all of them up in a single pass over the attribute list,
+    	rather than one pass per name, and converts each one as
+    	QueryIntAttribute() would. Entries of 'values' whose attribute is
+    	missing or can't be converted are left untouched, so they can be
+    	preset to defaults. Returns the number of attributes converted.
+
+    	@verbatim
+    	static const char* const names[] = { "r", "g", "b", "a" };
+    	int rgba[4] = { 0, 0, 0, 255 };
+    	colorElement->QueryIntAttributes( names, rgba, 4 );
+    	@endverbatim
+    */
+    int QueryIntAttributes( const char* const* names, int* values, int count ) const;
+
 	
     /** Given an attribute name, QueryAttribute() returns
     	XML_SUCCESS, XML_WRONG_ATTRIBUTE_TYPE if the conversion
@@ -1627,6 +1749,88 @@ enum Whitespace {
 };
 
 
+/** The memory an XMLDocument allocates its nodes and attributes from,
+	plus a buffer for the text being parsed.
+
+	Every document has an arena of its own unless one is passed to its
+	constructor. Documents sharing an arena reuse the items the previous
+	ones freed, and the blocks are only returned to the system when the
+	arena is cleared or destroyed, so loading document after document
+	stops allocating once the arena has grown to fit the largest one:
+
+	@verbatim
+	XMLArena arena;
+	for( int i = 0; i < count; ++i ) {
+		XMLDocument doc( true, PRESERVE_WHITESPACE, &arena );
+		doc.LoadFile( names[i] );
+		...
+	}
+	@endverbatim
+
+	An arena is not thread safe; the documents using it have to live
+	on the same thread. A document parsing on several threads, see
+	SetParseThreadCount(), hands the free items of the arena to its
+	threads itself.
+*/
+class TINYXML2_LIB XMLArena
+{
+    friend class XMLDocument;
+public:
+    XMLArena();
+    ~XMLArena();
+
+    /**
+    	Rebuild the free lists so new nodes are handed out in address
+    	order again, keeping all the memory. Every document using the
+    	arena must have been cleared or deleted.
+    */
+    void Reset();
+
+    /**
+    	Release all the memory. Every document using the arena must have
+    	been cleared or deleted.
+    */
+    void Clear();
+
+    /// Usage of the element pool.
+    XMLPoolStats ElementStats() const	{
+        return _elementPool.Stats();
+    }
+    /// Usage of the attribute pool.
+    XMLPoolStats AttributeStats() const	{
+        return _attributePool.Stats();
+    }
+    /// Usage of the text pool.
+    XMLPoolStats TextStats() const		{
+        return _textPool.Stats();
+    }
+    /// Usage of the comment pool; declarations and unknowns live here too.
+    XMLPoolStats CommentStats() const	{
+        return _commentPool.Stats();
+    }
+    /// Capacity of the text buffer kept for the next document, in bytes.
+    size_t CharBufferSize() const		{
+        return _charBufferSize;
+    }
+
+private:
+    XMLArena( const XMLArena& );	// not supported
+    void operator=( const XMLArena& );	// not supported
+
+    char* AcquireCharBuffer( size_t size );
+    bool ReleaseCharBuffer( char* buffer );
+
+    MemPoolT< sizeof(XMLElement) >	 _elementPool;
+    MemPoolT< sizeof(XMLAttribute) > _attributePool;
+    MemPoolT< sizeof(XMLText) >		 _textPool;
+    MemPoolT< sizeof(XMLComment) >	 _commentPool;
+
+    char*	_charBuffer;
+    size_t	_charBufferSize;
+    bool	_charBufferInUse;
+};
+
+
 /** A Document binds together all the functionality.
 	It can be saved, loaded, and printed to the screen.
 	All Nodes are connected and allocated to a Document.
@@ -1643,8 +1847,12 @@ class TINYXML2_LIB XMLDocument : public XMLNode
     friend class XMLDeclaration;
     friend class XMLUnknown;
 public:
-    /// constructor
-    XMLDocument( bool processEntities = true, Whitespace whitespaceMode = PRESERVE_WHITESPACE );
+    /**
+    	Constructor. By default the document allocates its nodes from
+    	memory of its own; pass an 'arena' to share one with other
+    	documents instead. The arena must outlive the document.
+    */
+    XMLDocument( bool processEntities = true, Whitespace whitespaceMode = PRESERVE_WHITESPACE, XMLArena* arena = 0 );
     ~XMLDocument();
 
     virtual XMLDocument* ToDocument()				{
@@ -1688,6 +1896,64 @@ public:
     */
     XMLError LoadFile( FILE* );
 
+    /**
+    	Load an XML file from disk by mapping it privately
+    	(copy-on-write) into memory and parsing it in place,
+    	instead of reading it into a separately allocated buffer.
+
+    	The nodes reference the mapping, so it is kept until the
+    	document is cleared or destroyed. Call Clear() once the
+    	data has been extracted to release it early. On platforms
+    	without mmap this is equivalent to LoadFile( filename ).
+
+    	Returns XML_SUCCESS (0) on success, or
+    	an errorID.
+    */
+    XMLError LoadFileMapped( const char* filename );
+
+    /**
+    	Callback receiving one range of the children of the root
+    	element. See SetParseRangeCallback().
+    */
+    typedef void (*ParseRangeCallback)( XMLDocument* range, int rangeIndex, void* userData );
+
+    /**
+    	Sets the number of threads Parse() and LoadFile() may use.
+    	The children of the root element are split into contiguous
+    	ranges at top level element boundaries, each range is parsed
+    	into its own pools on its own thread, and the ranges are then
+    	linked back under the root element in document order.
+
+    	Zero uses one thread per hardware thread. One, the default,
+    	always parses serially. Small documents, and documents the
+    	splitter doesn't recognize (no root element, processing
+    	instructions or DTD subsets inside the root...), are parsed
+    	serially regardless, with identical results.
+    */
+    void SetParseThreadCount( int count ) {
+        _parseThreadCount = count;
+    }
+    int ParseThreadCount() const {
+        return _parseThreadCount;
+    }
+
+    /**
+    	Instead of linking each parsed range under the root element,
+    	hand it to 'callback' on the thread that parsed it. The
+    	children of 'range' are that range's children of the root
+    	element, in document order, and 'rangeIndex' is the position
+    	of the range in the document. 'range' is destroyed when the
+    	callback returns, and the root element is left empty.
+
+    	Callbacks run concurrently. If the document can't be split,
+    	it is parsed serially and the callback is not called.
+    	Pass a null callback to go back to linking.
+    */
+    void SetParseRangeCallback( ParseRangeCallback callback, void* userData ) {
+        _parseRangeCallback = callback;
+        _parseRangeUserData = userData;
+    }
+
     /**
     	Save the XML file to disk.
     	Returns XML_SUCCESS (0) on success, or
@@ -1858,7 +2124,11 @@ private:
     mutable StrPair	_errorStr;
     int             _errorLineNum;
     char*			_charBuffer;
+    size_t			_charBufferMapSize;	// non-zero if _charBuffer is a file mapping
     int				_parseCurLineNum;
+    int				_parseThreadCount;
+    ParseRangeCallback _parseRangeCallback;
+    void*			_parseRangeUserData;
 	// Memory tracking does add some overhead.
 	// However, the code assumes that you don't
 	// have a bunch of unlinked nodes around.
@@ -1867,14 +2137,21 @@ private:
 	// and the performance is the same.
 	DynArray<XMLNode*, 10> _unlinked;
 
-    MemPoolT< sizeof(XMLElement) >	 _elementPool;
-    MemPoolT< sizeof(XMLAttribute) > _attributePool;
-    MemPoolT< sizeof(XMLText) >		 _textPool;
-    MemPoolT< sizeof(XMLComment) >	 _commentPool;
+    XMLArena		_ownArena;
+    XMLArena*		_arena;
+    MemPoolT< sizeof(XMLElement) >&	 _elementPool;
+    MemPoolT< sizeof(XMLAttribute) >& _attributePool;
+    MemPoolT< sizeof(XMLText) >&	 _textPool;
+    MemPoolT< sizeof(XMLComment) >&	 _commentPool;
 
 	static const char* _errorNames[XML_ERROR_COUNT];
 
     void Parse();
+    bool ParseParallel( char* p );
+    void ParseRange( char* p, int lineNum, XMLDocument* owner, int rangeIndex );
+    void Retarget( XMLNode* node, const XMLDocument& from );
+    char* AllocateCharBuffer( size_t size );
+    void ReleaseCharBuffer();
 
     void SetError( XMLError error, int lineNum, const char* format, ... );
 
@@ -2145,7 +2422,34 @@ public:
     	with only required whitespace and newlines.
     */
     XMLPrinter( FILE* file=0, bool compact = false, int depth = 0 );
-    virtual ~XMLPrinter()	{}
+
+    /** Construct a printer that streams to 'file' through the
+    	caller-supplied 'buffer' of 'bufferSize' bytes. Output is
+    	collected in the buffer and written with a single fwrite()
+    	each time it fills up, so memory use stays constant however
+    	large the document is. The buffer is flushed at the end of
+    	a document, by Flush() and by the destructor; flush before
+    	closing the file when printing with the streaming API.
+    */
+    XMLPrinter( char* buffer, int bufferSize, FILE* file, bool compact = false, int depth = 0 );
+
+    /** Same as above, writing to the file descriptor 'fd' with
+    	write() rather than going through stdio.
+    */
+    XMLPrinter( char* buffer, int bufferSize, int fd, bool compact = false, int depth = 0 );
+
+    virtual ~XMLPrinter()	{
+        Flush();
+    }
+
+    /// If streaming through a buffer, write out everything printed so far.
+    void Flush();
+
+    /** True if writing to the file or file descriptor failed, in which
+    	case the output is incomplete. Output is dropped from the first
+    	failure on. Query it after Flush(), Print() or the end of a document.
+    */
+    bool WriteError() const;
 
     /** If streaming, write the BOM and declaration. */
     void PushHeader( bool writeBOM, bool writeDeclaration );
@@ -2186,6 +2490,7 @@ public:
 
     virtual bool VisitEnter( const XMLDocument& /*doc*/ );
     virtual bool VisitExit( const XMLDocument& /*doc*/ )			{
+        Flush();
         return true;
     }
 
@@ -2240,9 +2545,19 @@ protected:
 
 private:
     void PrintString( const char*, bool restrictedEntitySet );	// prints out, after detecting entities.
+    // Numbers never contain entities, so they skip PrintString().
+    void PushNumericAttribute( const char* name, const char* value );
+    void PushNumericText( const char* value );
+    void WriteStream( const char* data, size_t size );
+    void Init();
 
     bool _firstElement;
+    bool _writeError;
     FILE* _fp;
+    int _fd;
+    char* _streamBuffer;
+    int _streamBufferSize;
+    int _streamBufferUsed;
     int _depth;
     int _textDepth;
     bool _processEntities;
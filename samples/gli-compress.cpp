@@ -0,0 +1,120 @@
+#include <gli/compress.hpp>
+#include <gli/decompress.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+	enum pattern
+	{
+		PATTERN_GRADIENT,	// Every component changes linearly across the texture
+		PATTERN_FLAT		// Every block of 4x4 texels has a single color
+	};
+
+	gli::texture2d make_texture(pattern Pattern)
+	{
+		gli::texture2d Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(64, 48), 1);
+		for(int y = 0; y < Texture.extent().y; ++y)
+		for(int x = 0; x < Texture.extent().x; ++x)
+		{
+			glm::u8vec4 const Texel = Pattern == PATTERN_GRADIENT ?
+				glm::u8vec4(x * 4, y * 5, 255 - x * 2 - y, (x + y) * 2) :
+				glm::u8vec4(37 + x / 4 * 3, 201 - y / 4 * 7, 90 + x / 4 * (y / 4) % 50, 128 + x / 4 * 2);
+			Texture.store(gli::texture2d::extent_type(x, y), 0, Texel);
+		}
+		return Texture;
+	}
+
+	// Components stored by a format, transparency excluded, and whether it encodes alpha with a threshold
+	struct format_desc
+	{
+		gli::format Format;
+		int Components;
+		bool Alpha;
+		bool Punchthrough;
+	};
+
+	// Compress and decompress the texture, returns the number of texels with a component further from the source than MaxError
+	int test_round_trip(format_desc const& Desc, gli::compression_quality Quality, pattern Pattern, int MaxError)
+	{
+		int Error = 0;
+
+		gli::texture2d const Texture(make_texture(Pattern));
+		gli::texture2d const Compressed(gli::compress(Texture, Desc.Format, Quality));
+		gli::texture2d const Decompressed(gli::decompress(Compressed, gli::FORMAT_RGBA8_UNORM_PACK8));
+
+		Error += Compressed.format() == Desc.Format ? 0 : 1;
+		Error += Decompressed.extent() == Texture.extent() ? 0 : 1;
+		if(Error)
+			return Error;
+
+		for(int y = 0; y < Texture.extent().y; ++y)
+		for(int x = 0; x < Texture.extent().x; ++x)
+		{
+			glm::u8vec4 const Source = Texture.load<glm::u8vec4>(gli::texture2d::extent_type(x, y), 0);
+			glm::u8vec4 const Result = Decompressed.load<glm::u8vec4>(gli::texture2d::extent_type(x, y), 0);
+
+			// Transparent texels decode as transparent black
+			if(Desc.Punchthrough)
+			{
+				bool const Opaque = Source.a >= 128;
+				Error += Result.a == (Opaque ? 255 : 0) ? 0 : 1;
+				if(!Opaque)
+					continue;
+			}
+
+			int TexelError = 0;
+			for(int Component = 0; Component < Desc.Components; ++Component)
+				TexelError = glm::max(TexelError, std::abs(Source[Component] - Result[Component]));
+			if(Desc.Alpha)
+				TexelError = glm::max(TexelError, std::abs(Source.a - Result.a));
+			Error += TexelError <= MaxError ? 0 : 1;
+		}
+
+		return Error;
+	}
+
+	int test_formats()
+	{
+		int Error = 0;
+
+		// The color endpoints are stored in 5 and 6 bits with two interpolated colors between them,
+		// alpha and single channel blocks with 8 bits endpoints and six interpolated values
+		format_desc const Descs[] =
+		{
+			{gli::FORMAT_RGB_DXT1_UNORM_BLOCK8, 3, false, false},
+			{gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, 3, false, true},
+			{gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16, 3, true, false},
+			{gli::FORMAT_R_ATI1N_UNORM_BLOCK8, 1, false, false},
+			{gli::FORMAT_RG_ATI2N_UNORM_BLOCK16, 2, false, false}
+		};
+
+		for(std::size_t DescIndex = 0; DescIndex < sizeof(Descs) / sizeof(Descs[0]); ++DescIndex)
+		for(int Quality = gli::COMPRESSION_QUALITY_FIRST; Quality <= gli::COMPRESSION_QUALITY_LAST; ++Quality)
+		{
+			format_desc const& Desc = Descs[DescIndex];
+			bool const Color = Desc.Components == 3;
+			gli::compression_quality const CompressionQuality = static_cast<gli::compression_quality>(Quality);
+
+			int const FormatError =
+				test_round_trip(Desc, CompressionQuality, PATTERN_GRADIENT, Color ? 12 : 1) +
+				test_round_trip(Desc, CompressionQuality, PATTERN_FLAT, Color ? 4 : 0);
+			if(FormatError)
+				std::fprintf(stderr, "gli-compress: format %d, quality %d: %d errors\n", static_cast<int>(Desc.Format), Quality, FormatError);
+			Error += FormatError ? 1 : 0;
+		}
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_formats();
+
+	if(Error)
+		std::fprintf(stderr, "gli-compress: %d errors\n", Error);
+	return Error;
+}
@@ -0,0 +1,152 @@
+#include <gli/texture2d.hpp>
+#include <gli/duplicate.hpp>
+#include <gli/comparison.hpp>
+#include <gli/generate_mipmaps.hpp>
+#include <gli/execution.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+namespace
+{
+	gli::texture2d make_texture()
+	{
+		gli::texture2d Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(19, 11));
+		for(gli::texture2d::size_type Level = 0; Level < Texture.levels(); ++Level)
+		for(int y = 0; y < Texture.extent(Level).y; ++y)
+		for(int x = 0; x < Texture.extent(Level).x; ++x)
+			Texture.store(gli::texture2d::extent_type(x, y), Level, glm::u8vec4(x, y, Level, 255));
+		return Texture;
+	}
+
+	// Reading a duplicate shares the memory, writing either texture leaves the other unchanged
+	int test_isolation()
+	{
+		int Error = 0;
+
+		gli::texture2d Texture(make_texture());
+		gli::texture2d const Reference(gli::duplicate(Texture));
+		gli::texture2d Copy(gli::duplicate_on_write(Texture));
+
+		gli::texture2d const& ConstTexture = Texture;
+		gli::texture2d const& ConstCopy = Copy;
+		Error += ConstCopy.data() == ConstTexture.data() ? 0 : 1;
+		Error += Copy == Reference ? 0 : 1;
+
+		Copy.store(gli::texture2d::extent_type(1, 2), 1, glm::u8vec4(0, 0, 0, 0));
+		Error += ConstCopy.data() != ConstTexture.data() ? 0 : 1;
+		Error += Texture == Reference ? 0 : 1;
+		Error += Copy != Reference ? 0 : 1;
+		Error += Copy.load<glm::u8vec4>(gli::texture2d::extent_type(1, 2), 1) == glm::u8vec4(0, 0, 0, 0) ? 0 : 1;
+
+		gli::texture2d Second(gli::duplicate_on_write(Texture));
+		Texture.clear(glm::u8vec4(255));
+		Error += Second == Reference ? 0 : 1;
+		Error += Texture.load<glm::u8vec4>(gli::texture2d::extent_type(0, 0), 0) == glm::u8vec4(255) ? 0 : 1;
+
+		return Error;
+	}
+
+	// Images and views taken before the memory is copied address the copy afterwards
+	int test_views()
+	{
+		int Error = 0;
+
+		gli::texture2d Texture(make_texture());
+		gli::texture2d Copy(gli::duplicate_on_write(Texture));
+		gli::texture2d const Levels(Copy, 1, 2);
+		gli::image Image(Copy[1]);
+
+		Image.store(gli::image::extent_type(3, 4, 0), glm::u8vec4(7));
+		Error += Levels.load<glm::u8vec4>(gli::texture2d::extent_type(3, 4), 0) == glm::u8vec4(7) ? 0 : 1;
+		Error += Copy.load<glm::u8vec4>(gli::texture2d::extent_type(3, 4), 1) == glm::u8vec4(7) ? 0 : 1;
+		Error += Texture.load<glm::u8vec4>(gli::texture2d::extent_type(3, 4), 1) == glm::u8vec4(3, 4, 1, 255) ? 0 : 1;
+
+		return Error;
+	}
+
+	// Duplicating a subset of the levels copies it right away
+	int test_subset()
+	{
+		int Error = 0;
+
+		gli::texture2d Texture(make_texture());
+		gli::texture2d const Levels(Texture, 1, Texture.max_level());
+		gli::texture2d const Copy(gli::duplicate_on_write(Levels));
+
+		Error += Copy == Levels ? 0 : 1;
+		Error += Copy.data() != Levels.data() ? 0 : 1;
+
+		Texture.store(gli::texture2d::extent_type(0, 0), 1, glm::u8vec4(0));
+		Error += Copy.load<glm::u8vec4>(gli::texture2d::extent_type(0, 0), 0) == glm::u8vec4(0, 0, 1, 255) ? 0 : 1;
+
+		return Error;
+	}
+
+	// Runs every range on a thread of its own, the ranges starting together without synchronizing with each other
+	class executor_threads : public gli::executor
+	{
+	public:
+		void parallel_for(size_t Count, size_t Grain, task_type const& Task) override
+		{
+			std::atomic<bool> Start(false);
+			std::vector<std::thread> Threads;
+			for(size_t Begin = 0; Begin < Count; Begin += Grain)
+			{
+				size_t const End = Begin + Grain < Count ? Begin + Grain : Count;
+				Threads.push_back(std::thread([&Start, &Task, Begin, End]()
+				{
+					while(!Start.load(std::memory_order_relaxed)){}
+					Task(Begin, End);
+				}));
+			}
+
+			Start.store(true, std::memory_order_relaxed);
+			for(std::size_t ThreadIndex = 0; ThreadIndex < Threads.size(); ++ThreadIndex)
+				Threads[ThreadIndex].join();
+		}
+	};
+
+	// The bands of an operation running on several threads read the texture they write, sharing its memory until then.
+	// Built with ThreadSanitizer, reads of the memory racing with its copy are reported.
+	int test_executor()
+	{
+		int Error = 0;
+
+		// Each band fetches texels through the const accessors before writing its first texel
+		gli::texture2d Texture(gli::FORMAT_RGBA16_UNORM_PACK16, gli::texture2d::extent_type(512));
+		for(int y = 0; y < Texture.extent().y; ++y)
+		for(int x = 0; x < Texture.extent().x; ++x)
+			Texture.store(gli::texture2d::extent_type(x, y), 0, glm::u16vec4(x * 128, y * 128, (x ^ y) * 64, 65535));
+
+		gli::texture2d const Source(gli::duplicate(Texture));
+		gli::texture2d const Reference(gli::generate_mipmaps(gli::texture2d(gli::duplicate(Texture)), gli::FILTER_LINEAR));
+
+		gli::set_default_executor(std::make_shared<executor_threads>());
+		for(int Iteration = 0; Iteration < 4; ++Iteration)
+		{
+			gli::texture2d const Mipmaps(gli::generate_mipmaps(gli::texture2d(gli::duplicate_on_write(Texture)), gli::FILTER_LINEAR));
+			Error += Mipmaps == Reference ? 0 : 1;
+		}
+		gli::set_default_executor(nullptr);
+
+		Error += Texture == Source ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_isolation();
+	Error += test_views();
+	Error += test_subset();
+	Error += test_executor();
+
+	if(Error)
+		std::fprintf(stderr, "gli-copy-on-write: %d errors\n", Error);
+	return Error;
+}
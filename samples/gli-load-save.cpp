@@ -0,0 +1,155 @@
+#include <gli/texture2d.hpp>
+#include <gli/load_dds.hpp>
+#include <gli/load_ktx.hpp>
+#include <gli/save_dds.hpp>
+#include <gli/save_ktx.hpp>
+#include <gli/comparison.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	gli::texture2d make_texture()
+	{
+		gli::texture2d Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(37, 21));
+		for(gli::texture2d::size_type Level = 0; Level < Texture.levels(); ++Level)
+		for(int y = 0; y < Texture.extent(Level).y; ++y)
+		for(int x = 0; x < Texture.extent(Level).x; ++x)
+			Texture.store(gli::texture2d::extent_type(x, y), Level, glm::u8vec4(x, y, Level, 255));
+		return Texture;
+	}
+
+	// Textures of each target, with bytes that differ from one image to the next
+	std::vector<gli::texture> make_textures()
+	{
+		std::vector<gli::texture> Textures;
+		Textures.push_back(make_texture());
+		Textures.push_back(gli::texture(gli::TARGET_2D_ARRAY, gli::FORMAT_RGBA16_SFLOAT_PACK16, gli::texture::extent_type(16, 8, 1), 3, 1, 4));
+		Textures.push_back(gli::texture(gli::TARGET_CUBE, gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture::extent_type(8, 8, 1), 1, 6, 4));
+		Textures.push_back(gli::texture(gli::TARGET_CUBE_ARRAY, gli::FORMAT_RG8_UNORM_PACK8, gli::texture::extent_type(4, 4, 1), 2, 6, 1));
+		Textures.push_back(gli::texture(gli::TARGET_3D, gli::FORMAT_R8_UNORM_PACK8, gli::texture::extent_type(9, 5, 3), 1, 1, 2));
+		Textures.push_back(gli::texture(gli::TARGET_1D, gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture::extent_type(13, 1, 1), 1, 1, 1));
+		Textures.push_back(gli::texture(gli::TARGET_2D, gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16, gli::texture::extent_type(20, 12, 1), 1, 1, 3));
+
+		for(std::size_t TextureIndex = 1; TextureIndex < Textures.size(); ++TextureIndex)
+		{
+			// Bytes under 64 never make the exponent of a half or a float all ones, so every texel compares equal to itself
+			glm::u8* const Data = Textures[TextureIndex].data<glm::u8>();
+			for(std::size_t ByteIndex = 0, ByteCount = Textures[TextureIndex].size(); ByteIndex < ByteCount; ++ByteIndex)
+				Data[ByteIndex] = static_cast<glm::u8>((ByteIndex * 31 + TextureIndex) % 64);
+		}
+		return Textures;
+	}
+
+	typedef bool (*save_memory_func)(gli::texture const& Texture, std::vector<char>& Memory);
+	typedef bool (*save_file_func)(gli::texture const& Texture, FILE* File);
+	typedef bool (*save_write_func)(gli::texture const& Texture, gli::write_func const& Write);
+	typedef gli::texture (*load_memory_func)(char const* Data, std::size_t Size);
+
+	// Saving to memory, to a file and piece by piece produces the same bytes, which load as the saved texture
+	int test_round_trip(gli::texture const& Texture, save_memory_func SaveMemory, save_file_func SaveFile, save_write_func SaveWrite, load_memory_func Load)
+	{
+		int Error = 0;
+
+		std::vector<char> Memory;
+		Error += SaveMemory(Texture, Memory) ? 0 : 1;
+		Error += Load(&Memory[0], Memory.size()) == Texture ? 0 : 1;
+
+		FILE* File = std::tmpfile();
+		Error += File ? 0 : 1;
+		if(File)
+		{
+			Error += SaveFile(Texture, File) ? 0 : 1;
+			std::vector<char> Content(Memory.size() + 1);
+			std::rewind(File);
+			Error += std::fread(&Content[0], 1, Content.size(), File) == Memory.size() ? 0 : 1;
+			Content.pop_back();
+			Error += Content == Memory ? 0 : 1;
+			std::fclose(File);
+		}
+
+		std::vector<char> Pieces;
+		Error += SaveWrite(Texture, [&Pieces](void const* Data, std::size_t Size)
+		{
+			Pieces.insert(Pieces.end(), static_cast<char const*>(Data), static_cast<char const*>(Data) + Size);
+			return true;
+		}) ? 0 : 1;
+		Error += Pieces == Memory ? 0 : 1;
+
+		// A failed write stops the save
+		std::size_t WriteCount = 0;
+		Error += !SaveWrite(Texture, [&WriteCount](void const*, std::size_t)
+		{
+			return ++WriteCount < 2;
+		}) ? 0 : 1;
+		Error += WriteCount == 2 ? 0 : 1;
+
+		return Error;
+	}
+
+	int test_round_trips()
+	{
+		int Error = 0;
+
+		std::vector<gli::texture> const Textures(make_textures());
+		for(std::size_t TextureIndex = 0; TextureIndex < Textures.size(); ++TextureIndex)
+		{
+			Error += test_round_trip(Textures[TextureIndex], gli::save_dds, gli::save_dds, gli::save_dds, gli::load_dds);
+			Error += test_round_trip(Textures[TextureIndex], gli::save_ktx, gli::save_ktx, gli::save_ktx, gli::load_ktx);
+		}
+
+		return Error;
+	}
+
+	// Loading a subset of the images gives the same texture as a view of the saved one
+	int test_subset()
+	{
+		int Error = 0;
+
+		gli::texture const Texture(make_textures()[1]);
+		gli::texture const View(Texture, Texture.target(), Texture.format(), 1, 2, 0, 0, 1, 2);
+
+		std::vector<char> DDS;
+		Error += gli::save_dds(Texture, DDS) ? 0 : 1;
+		Error += gli::load_dds(&DDS[0], DDS.size(), 1, 2, 0, 0, 1, 2) == View ? 0 : 1;
+
+		std::vector<char> KTX;
+		Error += gli::save_ktx(Texture, KTX) ? 0 : 1;
+		Error += gli::load_ktx(&KTX[0], KTX.size(), 1, 2, 0, 0, 1, 2) == View ? 0 : 1;
+
+		return Error;
+	}
+
+	// Files cut in the middle of the images load as empty textures
+	int test_truncated()
+	{
+		int Error = 0;
+
+		gli::texture2d const Texture(make_texture());
+
+		std::vector<char> DDS;
+		Error += gli::save_dds(Texture, DDS) ? 0 : 1;
+		Error += gli::load_dds(&DDS[0], DDS.size() - 1).empty() ? 0 : 1;
+		Error += gli::load_dds(&DDS[0], DDS.size() / 2).empty() ? 0 : 1;
+
+		std::vector<char> KTX;
+		Error += gli::save_ktx(Texture, KTX) ? 0 : 1;
+		Error += gli::load_ktx(&KTX[0], KTX.size() - 1).empty() ? 0 : 1;
+		Error += gli::load_ktx(&KTX[0], KTX.size() / 2).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_round_trips();
+	Error += test_subset();
+	Error += test_truncated();
+
+	if(Error)
+		std::fprintf(stderr, "gli-load-save: %d errors\n", Error);
+	return Error;
+}
@@ -0,0 +1,180 @@
+#include <gli/texture2d.hpp>
+#include <gli/duplicate.hpp>
+#include <gli/execution.hpp>
+#include <gli/load_async.hpp>
+#include <gli/save_dds.hpp>
+#include <gli/memory_usage.hpp>
+#include <stdexcept>
+#include <cstdio>
+
+namespace
+{
+	// Counters of a tag, zero if the tag was never used
+	gli::memory_counters tag_counters(char const* Tag)
+	{
+		gli::memory_usage const Usage(gli::current_memory_usage());
+		std::map<std::string, gli::memory_counters>::const_iterator const It = Usage.Tags.find(Tag);
+		if(It != Usage.Tags.end())
+			return It->second;
+
+		gli::memory_counters const Counters = {0, 0, 0, 0};
+		return Counters;
+	}
+
+	// Allocations and deallocations are accounted for in the total, the format, the target and the tag of the storage
+	int test_counters()
+	{
+		int Error = 0;
+
+		gli::memory_usage const Before(gli::current_memory_usage());
+		size_t Size = 0;
+		{
+			gli::memory_tag const Tag("counters");
+			gli::texture2d const Texture(gli::FORMAT_RG16_UNORM_PACK16, gli::texture2d::extent_type(64, 32), 1);
+			Size = Texture.size();
+
+			gli::memory_usage const During(gli::current_memory_usage());
+			Error += During.Total.LiveBytes == Before.Total.LiveBytes + Size ? 0 : 1;
+			Error += During.Total.Allocations == Before.Total.Allocations + 1 ? 0 : 1;
+			Error += During.Formats.at(gli::FORMAT_RG16_UNORM_PACK16).LiveBytes == Size ? 0 : 1;
+			Error += During.Targets.at(gli::TARGET_2D).LiveBytes >= Size ? 0 : 1;
+			Error += During.Tags.at("counters").LiveBytes == Size ? 0 : 1;
+		}
+
+		gli::memory_usage const After(gli::current_memory_usage());
+		Error += After.Total.LiveBytes == Before.Total.LiveBytes ? 0 : 1;
+		Error += After.Total.Deallocations == Before.Total.Deallocations + 1 ? 0 : 1;
+		Error += After.Formats.at(gli::FORMAT_RG16_UNORM_PACK16).LiveBytes == 0 ? 0 : 1;
+		Error += After.Tags.at("counters").PeakBytes == Size ? 0 : 1;
+
+		return Error;
+	}
+
+	// Peaks restart from the live memory
+	int test_peaks()
+	{
+		int Error = 0;
+
+		gli::reset_memory_peaks();
+		gli::memory_usage const Before(gli::current_memory_usage());
+		Error += Before.Total.PeakBytes == Before.Total.LiveBytes ? 0 : 1;
+
+		size_t Size = 0;
+		{
+			gli::texture2d const Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(128), 1);
+			Size = Texture.size();
+		}
+
+		gli::memory_usage const After(gli::current_memory_usage());
+		Error += After.Total.PeakBytes >= After.Total.LiveBytes + Size ? 0 : 1;
+
+		gli::reset_memory_peaks();
+		gli::memory_usage const Reset(gli::current_memory_usage());
+		Error += Reset.Total.PeakBytes == Reset.Total.LiveBytes ? 0 : 1;
+		Error += Reset.Formats.at(gli::FORMAT_RGBA8_UNORM_PACK8).PeakBytes == Reset.Formats.at(gli::FORMAT_RGBA8_UNORM_PACK8).LiveBytes ? 0 : 1;
+
+		return Error;
+	}
+
+	// Storages allocated on the threads of an executor or of a loader are under the tag of the thread submitting the work
+	int test_threads()
+	{
+		int Error = 0;
+
+		gli::memory_tag const Tag("threads");
+
+		gli::executor_thread_pool Executor(4);
+		Executor.parallel_for(16, 1, [](size_t, size_t)
+		{
+			gli::texture2d const Texture(gli::FORMAT_R8_UNORM_PACK8, gli::texture2d::extent_type(16), 1);
+		});
+		Error += tag_counters("threads").Allocations == 16 ? 0 : 1;
+
+		gli::texture2d const Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(16), 1);
+		std::vector<char> Data;
+		Error += gli::save_dds(Texture, Data) ? 0 : 1;
+
+		// Loaded textures reference the data, their duplicates are allocated on the worker threads
+		std::vector<gli::load_handle> Handles;
+		{
+			gli::loader Loader(2);
+			for(int Index = 0; Index < 8; ++Index)
+				Handles.push_back(Loader.load(Data, 0, [](gli::texture const& Loaded)
+				{
+					return gli::duplicate(Loaded);
+				}));
+			Loader.wait();
+		}
+		for(std::size_t Index = 0; Index < Handles.size(); ++Index)
+			Error += Handles[Index].get().empty() ? 1 : 0;
+		Error += tag_counters("threads").Allocations == 16 + 1 + 8 ? 0 : 1;
+
+		return Error;
+	}
+
+	// Memory shared for copy on write is accounted for once, its copy under the tag of the storage written
+	int test_copy_on_write()
+	{
+		int Error = 0;
+
+		gli::texture2d Copy;
+		size_t Size = 0;
+		{
+			gli::memory_tag const Tag("copy-on-write");
+			gli::texture2d const Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(32), 1);
+			Size = Texture.size();
+
+			Copy = gli::texture2d(gli::duplicate_on_write(Texture));
+			Error += tag_counters("copy-on-write").Allocations == 1 ? 0 : 1;
+			Error += tag_counters("copy-on-write").LiveBytes == Size ? 0 : 1;
+		}
+
+		// The source was released, the copy holds the memory alone and is written in place
+		Error += tag_counters("copy-on-write").LiveBytes == Size ? 0 : 1;
+		Copy.store(gli::texture2d::extent_type(0, 0), 0, glm::u8vec4(1));
+		Error += tag_counters("copy-on-write").Allocations == 1 ? 0 : 1;
+
+		gli::texture2d const Second(gli::duplicate_on_write(Copy));
+		Copy.store(gli::texture2d::extent_type(1, 0), 0, glm::u8vec4(2));
+		Error += tag_counters("copy-on-write").Allocations == 2 ? 0 : 1;
+		Error += tag_counters("copy-on-write").LiveBytes == Size * 2 ? 0 : 1;
+
+		return Error;
+	}
+
+	// Exceptions of the dump function don't escape the deallocation of a storage
+	int test_dump()
+	{
+		int Error = 0;
+
+		int Calls = 0;
+		gli::set_memory_dump([&Calls](gli::memory_usage const&)
+		{
+			++Calls;
+			throw std::runtime_error("dump");
+		}, std::chrono::milliseconds(0));
+		{
+			gli::texture2d const Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(8), 1);
+		}
+		gli::set_memory_dump(gli::memory_dump_func(), std::chrono::milliseconds(0));
+
+		Error += Calls == 2 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_counters();
+	Error += test_peaks();
+	Error += test_threads();
+	Error += test_copy_on_write();
+	Error += test_dump();
+
+	if(Error)
+		std::fprintf(stderr, "gli-memory-usage: %d errors\n", Error);
+	return Error;
+}
@@ -93,7 +93,8 @@ private:
 	void load_database(char const* Filename)
 	{
 		XMLDocument Document;
-		Document.LoadFile(Filename);
+		Document.SetParseThreadCount(0);
+		Document.LoadFileMapped(Filename);
 
 		XMLElement* SquaresElement = Document.FirstChildElement("squares");
 
@@ -106,14 +107,18 @@ private:
 			palette Palette;
 			for (XMLElement* ColorElement = PaletteElement->FirstChildElement("color"); ColorElement; ColorElement = ColorElement->NextSiblingElement("color"))
 			{
-				std::size_t const ColorIndex = ColorElement->IntAttribute("index");
+				static char const* const ColorAttributes[] = {"index", "r", "g", "b", "a"};
+				int Color[5] = {0, 0, 0, 0, 0};
+				ColorElement->QueryIntAttributes(ColorAttributes, Color, 5);
+
+				std::size_t const ColorIndex = Color[0];
 				if (ColorIndex >= Palette.size())
 					Palette.resize(ColorIndex + 1);
 
-				Palette[ColorIndex].r = static_cast<unsigned char>(ColorElement->IntAttribute("r"));
-				Palette[ColorIndex].g = static_cast<unsigned char>(ColorElement->IntAttribute("g"));
-				Palette[ColorIndex].b = static_cast<unsigned char>(ColorElement->IntAttribute("b"));
-				Palette[ColorIndex].a = static_cast<unsigned char>(ColorElement->IntAttribute("a"));
+				Palette[ColorIndex].r = static_cast<unsigned char>(Color[1]);
+				Palette[ColorIndex].g = static_cast<unsigned char>(Color[2]);
+				Palette[ColorIndex].b = static_cast<unsigned char>(Color[3]);
+				Palette[ColorIndex].a = static_cast<unsigned char>(Color[4]);
 			}
 
 			Palettes[PaletteIndex] = Palette;
@@ -127,10 +132,14 @@ private:
 
 			for (XMLElement* DrawElement = ComponentElement->FirstChildElement("draw"); DrawElement; DrawElement = DrawElement->NextSiblingElement("draw"))
 			{
+				static char const* const DrawAttributes[] = {"column", "row", "color-index"};
+				int Values[3] = {0, 0, 0};
+				DrawElement->QueryIntAttributes(DrawAttributes, Values, 3);
+
 				draw Draw;
-				Draw.Column = DrawElement->IntAttribute("column");
-				Draw.Row = DrawElement->IntAttribute("row");
-				Draw.ColorIndex = DrawElement->IntAttribute("color-index");
+				Draw.Column = Values[0];
+				Draw.Row = Values[1];
+				Draw.ColorIndex = Values[2];
 				Component.Draws.push_back(Draw);
 			}
 
@@ -0,0 +1,145 @@
+#include <tinyxml2.h>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+	// Large enough to be split in several ranges, with every kind of node among the root children
+	std::string make_document(int Count)
+	{
+		std::string Document("<?xml version=\"1.0\"?>\n<!-- prolog -->\n<scene version=\"2\">\n");
+		char Buffer[512];
+		for(int i = 0; i < Count; ++i)
+		{
+			std::snprintf(Buffer, sizeof(Buffer),
+				"\t<mesh id=\"%d\" name='mesh &amp; %d' scale=\"%d.5\">\n"
+				"\t\t<vertex x=\"%d\" y=\"-%d\"/><vertex x=\"1e%d\" y=\"0\"/>\n"
+				"\t\t<!-- comment %d -->\n"
+				"\t\t<text>%d &lt; %d</text><data><![CDATA[<raw %d>]]></data>\n"
+				"\t</mesh>\n",
+				i, i, i, i, i, i % 30, i, i, i + 1, i);
+			Document += Buffer;
+
+			// Ranges can't start after text
+			if(i % 100 == 0)
+				Document += "\tloose text\n";
+		}
+		Document += "</scene>\n<!-- epilogue -->\n";
+		return Document;
+	}
+
+	std::string print(tinyxml2::XMLDocument const& Document)
+	{
+		tinyxml2::XMLPrinter Printer;
+		Document.Print(&Printer);
+		return std::string(Printer.CStr());
+	}
+
+	void count_range(tinyxml2::XMLDocument*, int, void* UserData)
+	{
+		++*static_cast<int*>(UserData);
+	}
+
+	// Parsing on several threads builds the same tree as parsing serially
+	int test_equivalence()
+	{
+		int Error = 0;
+
+		std::string const Text(make_document(4000));
+
+		tinyxml2::XMLDocument Serial;
+		Error += Serial.Parse(Text.c_str(), Text.size()) == tinyxml2::XML_SUCCESS ? 0 : 1;
+
+		int const ThreadCounts[] = {2, 3, 8, 0};
+		for(std::size_t Index = 0; Index < sizeof(ThreadCounts) / sizeof(ThreadCounts[0]); ++Index)
+		{
+			tinyxml2::XMLDocument Parallel;
+			Parallel.SetParseThreadCount(ThreadCounts[Index]);
+			Error += Parallel.Parse(Text.c_str(), Text.size()) == tinyxml2::XML_SUCCESS ? 0 : 1;
+			Error += print(Parallel) == print(Serial) ? 0 : 1;
+			Error += Parallel.RootElement()->LastChildElement("mesh")->IntAttribute("id") == 3999 ? 0 : 1;
+		}
+
+		// The document is actually split
+		int RangeCount = 0;
+		tinyxml2::XMLDocument Ranges;
+		Ranges.SetParseThreadCount(4);
+		Ranges.SetParseRangeCallback(count_range, &RangeCount);
+		Error += Ranges.Parse(Text.c_str(), Text.size()) == tinyxml2::XML_SUCCESS ? 0 : 1;
+		Error += RangeCount > 1 ? 0 : 1;
+
+		return Error;
+	}
+
+	// Errors in the middle of a range are reported as the serial parser does
+	int test_errors()
+	{
+		int Error = 0;
+
+		std::string Text(make_document(4000));
+		std::size_t const Position = Text.find("<text>2000 ");
+		Text.replace(Position, 6, "<txet>");
+
+		tinyxml2::XMLDocument Serial;
+		tinyxml2::XMLDocument Parallel;
+		Parallel.SetParseThreadCount(4);
+		Serial.Parse(Text.c_str(), Text.size());
+		Parallel.Parse(Text.c_str(), Text.size());
+
+		Error += Serial.Error() ? 0 : 1;
+		Error += Parallel.ErrorID() == Serial.ErrorID() ? 0 : 1;
+		Error += Parallel.ErrorLineNum() == Serial.ErrorLineNum() ? 0 : 1;
+		Error += Parallel.RootElement() == 0 ? 0 : 1;
+
+		return Error;
+	}
+
+	// Parsing document after document in a shared arena reuses the memory of the first one.
+	// The threads borrow free items from the arena as they go, so a few more blocks may be needed
+	int test_arena()
+	{
+		int Error = 0;
+
+		std::string const Text(make_document(4000));
+		tinyxml2::XMLArena Arena;
+
+		int FirstBlocks = 0;
+		int Blocks = 0;
+		int FirstHighWater = 0;
+		for(int Iteration = 0; Iteration < 16; ++Iteration)
+		{
+			tinyxml2::XMLDocument Document(true, tinyxml2::PRESERVE_WHITESPACE, &Arena);
+			Document.SetParseThreadCount(4);
+			Error += Document.Parse(Text.c_str(), Text.size()) == tinyxml2::XML_SUCCESS ? 0 : 1;
+
+			// Every element of the document is live at once, on each load
+			int const HighWater = Arena.ElementStats().highWater;
+			Error += HighWater == Arena.ElementStats().currentAllocs ? 0 : 1;
+			Document.Clear();
+
+			Blocks = Arena.ElementStats().blocks + Arena.AttributeStats().blocks + Arena.TextStats().blocks + Arena.CommentStats().blocks;
+			if(Iteration == 0)
+			{
+				FirstBlocks = Blocks;
+				FirstHighWater = HighWater;
+			}
+			Error += HighWater == FirstHighWater ? 0 : 1;
+		}
+		Error += Blocks <= FirstBlocks + FirstBlocks / 64 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_equivalence();
+	Error += test_errors();
+	Error += test_arena();
+
+	if(Error)
+		std::fprintf(stderr, "xml-parse-parallel: %d errors\n", Error);
+	return Error;
+}